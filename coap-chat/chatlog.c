@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - observable log of recent messages
+ *
+ * Keeps the last CHAT_LOG_SIZE messages in a ring buffer, numbered from 1.
+ * A GET for /chat/log returns the latest message, as "<seq> <msg>", and an
+ * observer is notified of each new message. A GET with query "seq=<n>" returns
+ * all messages from <n> on, one per line, via Block2.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gcoap.h"
+#include "net/nanocoap_sock.h"
+#include "random.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define CHAT_LOG_PATH       "/chat/log"
+#define CHAT_LOG_BLKSIZE    (64U)
+#define CHAT_LOG_QUERY      "seq="
+
+typedef struct {
+    uint32_t seq;
+    uint8_t len;
+    char msg[CHAT_MSG_MAX];
+} chat_log_entry_t;
+
+static chat_log_entry_t _log[CHAT_LOG_SIZE];
+static uint32_t _next_seq = 1;
+static const coap_resource_t *_log_resource;
+
+/* Returns the entry for seq, or NULL if not in the log. */
+static chat_log_entry_t *_get(uint32_t seq)
+{
+    chat_log_entry_t *entry = &_log[seq % CHAT_LOG_SIZE];
+    return (seq && entry->seq == seq) ? entry : NULL;
+}
+
+/*
+ * Writes "<seq> <msg>" for an entry. With a slicer, writes the part for the
+ * current block. Otherwise truncates the message to fit in 'max' bytes.
+ * Returns length written.
+ */
+static size_t _put_entry(coap_block_slicer_t *slicer, uint8_t *bufpos,
+                         const chat_log_entry_t *entry, size_t max)
+{
+    char seq_str[11];
+    size_t seq_len = fmt_u32_dec(seq_str, entry->seq);
+    uint8_t *start = bufpos;
+
+    if (slicer) {
+        bufpos += coap_blockwise_put_bytes(slicer, bufpos, (uint8_t *)seq_str,
+                                           seq_len);
+        bufpos += coap_blockwise_put_char(slicer, bufpos, ' ');
+        bufpos += coap_blockwise_put_bytes(slicer, bufpos,
+                                           (uint8_t *)entry->msg, entry->len);
+    }
+    else if (max > seq_len + 1) {
+        size_t len = max - seq_len - 1;
+        if (len > entry->len) {
+            len = entry->len;
+        }
+        memcpy(bufpos, seq_str, seq_len);
+        bufpos += seq_len;
+        *bufpos++ = ' ';
+        memcpy(bufpos, entry->msg, len);
+        bufpos += len;
+    }
+    return bufpos - start;
+}
+
+/* Sends a notification for the entry, if there is an observer. */
+static void _notify(const chat_log_entry_t *entry)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    if (gcoap_obs_init(&pdu, buf, GCOAP_PDU_BUF_SIZE, _log_resource)
+            != GCOAP_OBS_INIT_OK) {
+        return;
+    }
+    coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
+    size_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+    /* a long message is truncated; fetch the log for all of it */
+    len += _put_entry(NULL, pdu.payload, entry, pdu.payload_len);
+    gcoap_obs_send(buf, len, _log_resource);
+}
+
+void chat_log_init(const coap_resource_t *resource)
+{
+    _log_resource = resource;
+}
+
+uint32_t chat_log_add(const char *msg, size_t len)
+{
+    chat_log_entry_t *entry = &_log[_next_seq % CHAT_LOG_SIZE];
+
+    if (len > CHAT_MSG_MAX) {
+        len = CHAT_MSG_MAX;
+    }
+    entry->seq = _next_seq++;
+    entry->len = len;
+    memcpy(entry->msg, msg, len);
+
+    _notify(entry);
+    return entry->seq;
+}
+
+ssize_t chat_log_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
+{
+    (void)ctx;
+    uint8_t *query;
+    ssize_t query_len = coap_opt_get_opaque(pdu, COAP_OPT_URI_QUERY, &query);
+    size_t prefix_len = strlen(CHAT_LOG_QUERY);
+
+    if (query_len <= 0) {
+        /* latest message only; the observable representation */
+        chat_log_entry_t *entry = _get(_next_seq - 1);
+
+        gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+        coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
+        ssize_t plen = coap_opt_finish(pdu, entry ? COAP_OPT_FINISH_PAYLOAD
+                                                  : COAP_OPT_FINISH_NONE);
+        if (entry) {
+            plen += _put_entry(NULL, pdu->payload, entry, pdu->payload_len);
+        }
+        return plen;
+    }
+
+    if ((size_t)query_len <= prefix_len || (size_t)query_len > prefix_len + 10
+            || memcmp(query, CHAT_LOG_QUERY, prefix_len) != 0) {
+        return gcoap_response(pdu, buf, len, COAP_CODE_BAD_REQUEST);
+    }
+    char seq_str[11] = { 0 };
+    memcpy(seq_str, query + prefix_len, query_len - prefix_len);
+    uint32_t seq = strtoul(seq_str, NULL, 10);
+
+    /* start from the oldest message still in the log */
+    uint32_t oldest = (_next_seq > CHAT_LOG_SIZE) ? _next_seq - CHAT_LOG_SIZE : 1;
+    if (seq < oldest) {
+        seq = oldest;
+    }
+
+    coap_block_slicer_t slicer;
+    coap_block2_init(pdu, &slicer);
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
+    coap_opt_add_block2(pdu, &slicer, 1);
+    ssize_t plen = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    for (; seq < _next_seq; seq++) {
+        chat_log_entry_t *entry = _get(seq);
+        if (entry) {
+            plen += _put_entry(&slicer, buf + plen, entry, 0);
+            plen += coap_blockwise_put_char(&slicer, buf + plen, '\n');
+        }
+    }
+    coap_block2_finish(&slicer);
+
+    return plen;
+}
+
+int chat_log_fetch(sock_udp_ep_t *remote, uint32_t seq)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[2];
+    char query[16] = CHAT_LOG_QUERY;
+    coap_block1_t block;
+    coap_pkt_t pdu;
+    unsigned msgid = random_uint32();
+
+    query[strlen(CHAT_LOG_QUERY) + fmt_u32_dec(&query[strlen(CHAT_LOG_QUERY)],
+                                                seq)] = '\0';
+    uint16_t token_val = random_uint32();
+    memcpy(token, &token_val, sizeof(token));
+    coap_block_object_init(&block, 0, CHAT_LOG_BLKSIZE, 0);
+
+    do {
+        uint8_t *bufpos = buf;
+        bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, token,
+                                 sizeof(token), COAP_METHOD_GET, msgid++);
+        bufpos += coap_opt_put_uri_path(bufpos, 0, CHAT_LOG_PATH);
+        bufpos += coap_put_option(bufpos, COAP_OPT_URI_PATH, COAP_OPT_URI_QUERY,
+                                  (uint8_t *)query, strlen(query));
+        bufpos += coap_opt_put_block2_control(bufpos, COAP_OPT_URI_QUERY, &block);
+
+        pdu.hdr = (coap_hdr_t *)buf;
+        pdu.payload = bufpos;
+        pdu.payload_len = 0;
+
+        ssize_t res = nanocoap_request(&pdu, NULL, remote, sizeof(buf));
+        if (res < 0 || coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS) {
+            DEBUG("[CoAP] chat_log: fetch failed: %d\n", (int)res);
+            return -1;
+        }
+        printf("%.*s", pdu.payload_len, (char *)pdu.payload);
+
+        /* reuse block size provided by server and request next block */
+        if (!coap_get_block2(&pdu, &block)) {
+            break;
+        }
+        block.blknum++;
+    } while (block.more);
+
+    return 0;
+}
@@ -18,23 +18,51 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "net/gcoap.h"
+#include "net/nanocoap_sock.h"
+#include "random.h"
+#include "xtimer.h"
+
+#include "coap_chat.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
 
 #define COAP_CHAT_PATH      "/chat"
 
+/* No-Response option, RFC 7967, and its value to suppress all responses */
+#ifndef COAP_OPT_NO_RESPONSE
+#define COAP_OPT_NO_RESPONSE    (258)
+#endif
+#define NO_RESPONSE_ALL         (0x1A)
+
+/* Block size to send a message too long for a single PDU */
+#ifndef CHAT_BLOCK1_SIZE
+#define CHAT_BLOCK1_SIZE        (64U)
+#endif
+
+/* Reassembly of a message received in Block1 requests. Blocks are matched by
+ * message tag, so only one message may be in transfer at a time. */
+static struct {
+    bool active;
+    uint8_t tag_len;
+    uint8_t tag[CHAT_TAG_MAX];
+    size_t len;
+    char msg[CHAT_MSG_MAX];
+} _rx;
+
 static ssize_t _chat_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx);
 
-/* CoAP resources */
+/* CoAP resources; must be sorted by path */
 static const coap_resource_t _resources[] = {
-    { COAP_CHAT_PATH, COAP_POST, _chat_handler, NULL },
+    { COAP_CHAT_PATH, COAP_GET | COAP_POST, _chat_handler, NULL },
+    { "/chat/log", COAP_GET, chat_log_handler, NULL },
 };
 
 static gcoap_listener_t _listener = {
@@ -43,78 +71,355 @@ static gcoap_listener_t _listener = {
     NULL
 };
 
+/*
+ * Adds a block to the message in reassembly. Returns the response code: 2.31 if
+ * more blocks are expected, 2.04 if the message is complete, or an error.
+ */
+static unsigned _reassemble(coap_pkt_t *pdu, coap_block1_t *block1,
+                            const uint8_t *tag, ssize_t tag_len)
+{
+    if (tag_len < 0 || tag_len > (ssize_t)CHAT_TAG_MAX) {
+        tag_len = 0;
+    }
+    if (block1->blknum == 0) {
+        _rx.active = true;
+        _rx.len = 0;
+        _rx.tag_len = tag_len;
+        memcpy(_rx.tag, tag, tag_len);
+    }
+    else if (!_rx.active || _rx.tag_len != tag_len
+                || memcmp(_rx.tag, tag, tag_len) != 0
+                || block1->offset > _rx.len) {
+        /* not the transfer in progress, or missed a block */
+        return COAP_CODE_REQUEST_ENTITY_INCOMPLETE;
+    }
+
+    if (block1->offset + pdu->payload_len > CHAT_MSG_MAX) {
+        _rx.active = false;
+        return COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+    }
+    memcpy(&_rx.msg[block1->offset], pdu->payload, pdu->payload_len);
+    _rx.len = block1->offset + pdu->payload_len;
+
+    if (block1->more) {
+        return COAP_CODE_CONTINUE;
+    }
+    _rx.active = false;
+    return COAP_CODE_CHANGED;
+}
+
+/* Writes an empty response, with a Block1 option if provided. */
+static ssize_t _response(coap_pkt_t *pdu, uint8_t *buf, size_t len,
+                         unsigned code, coap_block1_t *block1)
+{
+    gcoap_resp_init(pdu, buf, len, code);
+    if (block1) {
+        coap_opt_add_block1_control(pdu, block1);
+    }
+    return coap_opt_finish(pdu, COAP_OPT_FINISH_NONE);
+}
+
+/* Responds to a GET with our nickname, for discovery. */
+static ssize_t _nick_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len)
+{
+    const char *nick = chat_nick();
+    size_t nick_len = strlen(nick);
+
+    if (nick_len == 0) {
+        return _response(pdu, buf, len, COAP_CODE_404, NULL);
+    }
+    gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+    coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
+    ssize_t resp_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+    if (pdu->payload_len < nick_len) {
+        return _response(pdu, buf, len, COAP_CODE_INTERNAL_SERVER_ERROR, NULL);
+    }
+    memcpy(pdu->payload, nick, nick_len);
+    return resp_len + nick_len;
+}
+
 static ssize_t _chat_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx)
 {
     (void)ctx;
+    uint8_t *tag;
+    uint32_t no_resp = 0;
+    uint32_t sender = 0;
+    uint32_t start = xtimer_now_usec();
+    coap_block1_t block1;
+    coap_block1_t *blockp = NULL;
+    const char *msg = (char *)pdu->payload;
+    size_t msg_len = pdu->payload_len;
+    unsigned code;
+
+    if (coap_method2flag(coap_get_code_detail(pdu)) == COAP_GET) {
+        return _nick_handler(pdu, buf, len);
+    }
+
+    /* a multicast message asks not to be answered */
+    coap_opt_get_uint(pdu, COAP_OPT_NO_RESPONSE, &no_resp);
+
+    ssize_t tag_len = coap_opt_get_opaque(pdu, COAP_OPT_URI_QUERY, &tag);
+
+    if (coap_get_block1(pdu, &block1)) {
+        blockp = &block1;
+        code = _reassemble(pdu, &block1, tag, tag_len);
+        if (code != COAP_CODE_CHANGED) {
+            goto out;
+        }
+        msg = _rx.msg;
+        msg_len = _rx.len;
+    }
+    else if (msg_len > CHAT_MSG_MAX) {
+        /* rather than truncate it for the log and display */
+        code = COAP_CODE_REQUEST_ENTITY_TOO_LARGE;
+        goto out;
+    }
 
-    if (pdu->payload_len > 0) {
-        printf("\n[ CHAT ] %.*s\n\n", pdu->payload_len, (char *)pdu->payload);
-        return gcoap_response(pdu, buf, len, COAP_CODE_CHANGED);
+    if (tag_len > 0 && chat_tag_seen(tag, tag_len, &sender)) {
+        DEBUG("[CoAP] dropping duplicate %.*s\n", (int)tag_len, (char *)tag);
+        code = COAP_CODE_CHANGED;
+    }
+    else if (msg_len > 0) {
+        chat_display_post(sender, msg, msg_len);
+        chat_log_add(msg, msg_len);
+        code = COAP_CODE_CHANGED;
+    }
+    else {
+        code = COAP_CODE_BAD_REQUEST;
     }
-    return gcoap_response(pdu, buf, len, COAP_CODE_BAD_REQUEST);
+
+    out:
+    chat_display_handler_time(xtimer_now_usec() - start);
+    return no_resp ? 0 : _response(pdu, buf, len, code, blockp);
 }
 
-static size_t _send(uint8_t *buf, size_t len, char *addr_str)
+int coap_chat_init_remote(sock_udp_ep_t *remote, char *addr_str)
 {
     ipv6_addr_t addr;
-    sock_udp_ep_t remote;
 
-    remote.family = AF_INET6;
+    remote->family = AF_INET6;
 
     /* parse for interface */
     int iface = ipv6_addr_split_iface(addr_str);
     if (iface == -1) {
         if (gnrc_netif_numof() == 1) {
             /* assign the single interface found in gnrc_netif_numof() */
-            remote.netif = (uint16_t)gnrc_netif_iter(NULL)->pid;
+            remote->netif = (uint16_t)gnrc_netif_iter(NULL)->pid;
         }
         else {
-            remote.netif = SOCK_ADDR_ANY_NETIF;
+            remote->netif = SOCK_ADDR_ANY_NETIF;
         }
     }
     else {
         if (gnrc_netif_get_by_pid(iface) == NULL) {
             DEBUG("[CoAP] interface not valid");
-            return 0;
+            return -1;
         }
-        remote.netif = iface;
+        remote->netif = iface;
     }
 
     /* parse destination address */
     if (ipv6_addr_from_str(&addr, addr_str) == NULL) {
         DEBUG("[CoAP] unable to parse destination address");
-        return 0;
+        return -1;
     }
-    if ((remote.netif == SOCK_ADDR_ANY_NETIF) && ipv6_addr_is_link_local(&addr)) {
+    if ((remote->netif == SOCK_ADDR_ANY_NETIF) && ipv6_addr_is_link_local(&addr)) {
         DEBUG("[CoAP] must specify interface for link local target");
-        return 0;
+        return -1;
     }
-    memcpy(&remote.addr.ipv6[0], &addr.u8[0], sizeof(addr.u8));
+    memcpy(&remote->addr.ipv6[0], &addr.u8[0], sizeof(addr.u8));
 
     /* parse port */
-    remote.port = GCOAP_PORT;
+    remote->port = GCOAP_PORT;
+
+    return 0;
+}
+
+static void _resp_handler(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    (void)remote;
+    chat_peer_resp(req_state, pdu);
+}
+
+static size_t _send(uint8_t *buf, size_t len, sock_udp_ep_t *remote)
+{
+    if (ipv6_addr_is_multicast((ipv6_addr_t *)&remote->addr.ipv6[0])) {
+        /* no response expected, so don't tie up a gcoap request memo */
+        return (sock_udp_send(NULL, buf, len, remote) > 0) ? len : 0;
+    }
+    return gcoap_req_send2(buf, len, remote, _resp_handler);
+}
+
+/* Length of the message "nick: word word ..." */
+static size_t _msg_len(const char *nick, char **words, int count)
+{
+    size_t len = strlen(nick) + 1;
 
-    return gcoap_req_send2(buf, len, &remote, NULL);
+    for (int i = 0; i < count; i++) {
+        len += 1 + strlen(words[i]);
+    }
+    return len;
 }
 
-int coap_post(char *addr, char *msgbuf, size_t msglen)
+/* Writes bytes, or only the part for the current block with a slicer. */
+static size_t _put(coap_block_slicer_t *slicer, uint8_t *bufpos,
+                   const char *data, size_t len)
 {
-    assert(msglen < GCOAP_PDU_BUF_SIZE);
+    if (slicer) {
+        return coap_blockwise_put_bytes(slicer, bufpos, (uint8_t *)data, len);
+    }
+    memcpy(bufpos, data, len);
+    return len;
+}
+
+/*
+ * Writes the message "nick: word word ...". With a slicer, writes only the
+ * part for the current block. Returns length written.
+ */
+static size_t _put_msg(coap_block_slicer_t *slicer, uint8_t *bufpos,
+                       const char *nick, char **words, int count)
+{
+    uint8_t *start = bufpos;
 
+    bufpos += _put(slicer, bufpos, nick, strlen(nick));
+    bufpos += _put(slicer, bufpos, ":", 1);
+    for (int i = 0; i < count; i++) {
+        bufpos += _put(slicer, bufpos, " ", 1);
+        bufpos += _put(slicer, bufpos, words[i], strlen(words[i]));
+    }
+    return bufpos - start;
+}
+
+/*
+ * Sends a message too long for a single PDU in Block1 requests. Runs in the
+ * shell thread, and waits for the response to each block, since the message is
+ * read from the shell arguments.
+ */
+static int _post_blockwise(sock_udp_ep_t *remote, const char *tag,
+                           size_t tag_len, const char *nick, char **words,
+                           int count)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[2];
+    uint16_t token_val = random_uint32();
+    unsigned msgid = random_uint32();
+    coap_block_slicer_t slicer;
+    coap_pkt_t pdu;
+    unsigned blknum = 0;
+
+    memcpy(token, &token_val, sizeof(token));
+    do {
+        coap_block_slicer_init(&slicer, blknum++, CHAT_BLOCK1_SIZE);
+
+        uint8_t *bufpos = buf;
+        bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, token,
+                                 sizeof(token), COAP_METHOD_POST, msgid++);
+        bufpos += coap_opt_put_uri_path(bufpos, 0, COAP_CHAT_PATH);
+        bufpos += coap_put_option_ct(bufpos, COAP_OPT_URI_PATH, COAP_FORMAT_TEXT);
+        bufpos += coap_put_option(bufpos, COAP_OPT_CONTENT_FORMAT,
+                                  COAP_OPT_URI_QUERY, (uint8_t *)tag, tag_len);
+        bufpos += coap_opt_put_block1(bufpos, COAP_OPT_URI_QUERY, &slicer, 1);
+        *bufpos++ = 0xFF;
+
+        pdu.hdr = (coap_hdr_t *)buf;
+        pdu.payload = bufpos;
+        bufpos += _put_msg(&slicer, bufpos, nick, words, count);
+        pdu.payload_len = bufpos - pdu.payload;
+        coap_block1_finish(&slicer);
+
+        ssize_t res = nanocoap_request(&pdu, NULL, remote, sizeof(buf));
+        if (res < 0) {
+            DEBUG("[CoAP] block %u send failed: %d\n", blknum - 1, (int)res);
+            return -1;
+        }
+        if (coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS) {
+            printf("[CoAP] coap_post: rejected with %u.%02u\n",
+                   coap_get_code_class(&pdu), coap_get_code_detail(&pdu));
+            return -1;
+        }
+    } while (slicer.cur > slicer.end);
+
+    return 0;
+}
+
+int coap_post(char *addr, const char *nick, char **words, int count,
+              bool confirmable)
+{
     coap_pkt_t pdu;
     uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    char tag[CHAT_TAG_MAX];
+    sock_udp_ep_t remote;
     size_t len = 0;
 
-    gcoap_req_init(&pdu, buf, GCOAP_PDU_BUF_SIZE, COAP_POST, COAP_CHAT_PATH);
+    if (strchr(addr, ':') == NULL) {
+        /* a nickname, already resolved by discovery */
+        if (chat_discover_find(addr, &remote) < 0) {
+            puts("[CoAP] coap_post: unknown nickname; try 'chat discover'");
+            return -1;
+        }
+    }
+    else if (coap_chat_init_remote(&remote, addr) < 0) {
+        puts("[CoAP] coap_post: unable to parse destination");
+        return -1;
+    }
+    bool multicast = ipv6_addr_is_multicast((ipv6_addr_t *)&remote.addr.ipv6[0]);
+    if (multicast && confirmable) {
+        puts("[CoAP] coap_post: can't confirm a multicast msg");
+        return -1;
+    }
+    if (chat_nick()[0] == '\0') {
+        /* discoverable by the first nickname used */
+        chat_nick_set(nick);
+    }
+    size_t msglen = _msg_len(nick, words, count);
+    if (msglen > CHAT_MSG_MAX) {
+        /* the receiver keeps at most CHAT_MSG_MAX chars */
+        puts("[CoAP] coap_post: msg too long");
+        return -1;
+    }
+    size_t tag_len = chat_tag_write(tag);
 
-    memcpy(pdu.payload, msgbuf, msglen);
+    gcoap_req_init(&pdu, buf, GCOAP_PDU_BUF_SIZE, COAP_POST, COAP_CHAT_PATH);
+    if (confirmable) {
+        coap_hdr_set_type(pdu.hdr, COAP_TYPE_CON);
+    }
+    coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
+    coap_opt_add_opaque(&pdu, COAP_OPT_URI_QUERY, (uint8_t *)tag, tag_len);
+    if (multicast) {
+        coap_opt_add_uint(&pdu, COAP_OPT_NO_RESPONSE, NO_RESPONSE_ALL);
+    }
+    len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
 
-    len = gcoap_finish(&pdu, msglen, COAP_FORMAT_TEXT);
+    if (pdu.payload_len < msglen) {
+        if (multicast) {
+            puts("[CoAP] coap_post: msg too long");
+            return -1;
+        }
+        DEBUG("[CoAP] coap_post: sending %u bytes blockwise\n", (unsigned)msglen);
+        uint32_t start = xtimer_now_usec();
+        int res = _post_blockwise(&remote, tag, tag_len, nick, words, count);
+        chat_peer_done(&remote, res == 0, xtimer_now_usec() - start);
+        if (res < 0) {
+            puts("[CoAP] coap_post: msg send failed");
+            return -1;
+        }
+        return msglen;
+    }
+    /* compose directly in the PDU */
+    len += _put_msg(NULL, pdu.payload, nick, words, count);
 
     DEBUG("[CoAP] coap_post: sending msg ID %u, %u bytes\n",
           coap_get_id(&pdu), (unsigned) len);
 
-    if (!_send(buf, len, addr)) {
+    /* a group is not a peer, and would only crowd the table */
+    if (!multicast) {
+        chat_peer_sent(&remote, &pdu, confirmable);
+    }
+    if (!_send(buf, len, &remote)) {
+        if (!multicast) {
+            chat_peer_unsent(&pdu);
+        }
         puts("[CoAP] coap_post: msg send failed");
         return -1;
     }
@@ -123,5 +428,9 @@ int coap_post(char *addr, char *msgbuf, size_t msglen)
 
 void coap_init(void)
 {
+    chat_group_init();
+    chat_display_init();
+    chat_log_init(&_resources[1]);
     gcoap_register_listener(&_listener);
+    chat_discover_init();
 }
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - shared definitions
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef COAP_CHAT_H
+#define COAP_CHAT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Max length of a chat message, as "nick: text"
+ *
+ * A message too long for a single PDU is sent in Block1 requests. Each log and
+ * display entry, and the reassembly buffer, holds this many chars, so a larger
+ * value costs RAM. Entries store the length in a byte, so at most 255.
+ */
+#ifndef CHAT_MSG_MAX
+#define CHAT_MSG_MAX        (64U)
+#endif
+#if CHAT_MSG_MAX > 255
+#error "CHAT_MSG_MAX must be at most 255"
+#endif
+
+/**
+ * @brief   Count of recent messages kept in the /chat/log ring buffer
+ */
+#ifndef CHAT_LOG_SIZE
+#define CHAT_LOG_SIZE       (16U)
+#endif
+
+/**
+ * @brief   Count of recent message tags kept to suppress duplicates
+ */
+#ifndef CHAT_DEDUP_SIZE
+#define CHAT_DEDUP_SIZE     (16U)
+#endif
+
+/**
+ * @brief   Count of received messages queued for display
+ */
+#ifndef CHAT_DISPLAY_QUEUE_SIZE
+#define CHAT_DISPLAY_QUEUE_SIZE (8U)
+#endif
+
+/**
+ * @brief   Count of peers tracked for statistics, and found by discovery
+ */
+#ifndef CHAT_PEERS_MAX
+#define CHAT_PEERS_MAX      (8U)
+#endif
+
+/**
+ * @brief   Max length of a nickname, including terminator
+ */
+#ifndef CHAT_NICK_MAX
+#define CHAT_NICK_MAX       (16U)
+#endif
+
+/**
+ * @brief   Interval between peer discovery rounds, in seconds
+ */
+#ifndef CHAT_DISCOVERY_INTERVAL
+#define CHAT_DISCOVERY_INTERVAL     (60U)
+#endif
+
+/**
+ * @brief   Max length of a message tag Uri-Query, "m=<sender>-<seq>"
+ */
+#define CHAT_TAG_MAX        (2 + 8 + 1 + 10)
+
+/**
+ * @brief   Registers the chat resources, and starts helper threads
+ */
+void coap_init(void);
+
+/**
+ * @brief   Sends a chat message, "nick: word word ..."
+ *
+ * The message is written directly into the PDU, or sent blockwise if too long
+ * for a single PDU.
+ *
+ * @param[in] addr      destination address, optionally with %iface; or a
+ *                      nickname from discovery; modified
+ * @param[in] nick      sender nickname
+ * @param[in] words     words of the message text
+ * @param[in] count     count of @p words
+ * @param[in] confirmable   send as CON; only for a unicast @p addr
+ *
+ * @return  length sent
+ * @return  -1 on failure
+ */
+int coap_post(char *addr, const char *nick, char **words, int count,
+              bool confirmable);
+
+/**
+ * @brief   Initializes a remote endpoint for the chat port
+ *
+ * @param[out] remote   endpoint to initialize
+ * @param[in]  addr_str IPv6 address, optionally with %iface suffix; modified
+ *
+ * @return  0 on success
+ * @return  -1 on failure
+ */
+int coap_chat_init_remote(sock_udp_ep_t *remote, char *addr_str);
+
+/**
+ * @brief   Initializes the sender ID for message tags
+ */
+void chat_group_init(void);
+
+/**
+ * @brief   Writes the tag for a new message, with the next sequence number
+ *
+ * @param[out] buf  buffer for the tag, at least CHAT_TAG_MAX long
+ *
+ * @return  length of the tag
+ */
+size_t chat_tag_write(char *buf);
+
+/**
+ * @brief   Checks a received message tag against recently seen tags
+ *
+ * Remembers the tag if not seen.
+ *
+ * @param[in]  tag      tag from the message
+ * @param[in]  len      length of @p tag
+ * @param[out] sender   sender ID from the tag; 0 if not a valid tag
+ *
+ * @return  1 if the tag was seen already, so the message is a duplicate
+ * @return  0 if not seen, or not a valid tag
+ */
+int chat_tag_seen(const uint8_t *tag, size_t len, uint32_t *sender);
+
+/**
+ * @brief   Returns the count of duplicate messages suppressed
+ */
+uint32_t chat_group_dups(void);
+
+/**
+ * @brief   Shell handler for 'chat join|leave'
+ */
+int chat_group_cmd(int argc, char **argv);
+
+/**
+ * @brief   Records a request sent to a unicast peer, to match its response
+ *
+ * Call before sending, since the response may arrive before the send returns.
+ * Adds the peer to the table if new, replacing the least recently used entry
+ * if the table is full.
+ */
+void chat_peer_sent(const sock_udp_ep_t *remote, const coap_pkt_t *pdu,
+                    bool confirmable);
+
+/**
+ * @brief   Forgets a request recorded by chat_peer_sent(), which could not be
+ *          sent
+ */
+void chat_peer_unsent(const coap_pkt_t *pdu);
+
+/**
+ * @brief   Records the response, or timeout, for a request sent to a peer
+ */
+void chat_peer_resp(unsigned req_state, coap_pkt_t *pdu);
+
+/**
+ * @brief   Records a blockwise message, sent and completed synchronously
+ */
+void chat_peer_done(const sock_udp_ep_t *remote, bool ok, uint32_t latency);
+
+/**
+ * @brief   Prints statistics for each peer
+ */
+void chat_peer_stats(void);
+
+/**
+ * @brief   Starts the peer discovery thread
+ */
+void chat_discover_init(void);
+
+/**
+ * @brief   Starts a discovery round now, rather than at the next interval
+ */
+void chat_discover_now(void);
+
+/**
+ * @brief   Finds the endpoint for a nickname from discovery
+ *
+ * @param[in]  nick     nickname
+ * @param[out] remote   endpoint of the peer
+ *
+ * @return  0 on success
+ * @return  -1 if not found
+ */
+int chat_discover_find(const char *nick, sock_udp_ep_t *remote);
+
+/**
+ * @brief   Prints the peers found by discovery
+ */
+void chat_discover_list(void);
+
+/**
+ * @brief   Returns our nickname, returned for a GET on /chat; may be empty
+ */
+const char *chat_nick(void);
+
+/**
+ * @brief   Sets our nickname
+ *
+ * @return  0 on success
+ * @return  -1 if too long
+ */
+int chat_nick_set(const char *nick);
+
+/**
+ * @brief   Starts the display thread
+ */
+void chat_display_init(void);
+
+/**
+ * @brief   Queues a received message for display
+ *
+ * @return  0 on success
+ * @return  -1 if the queue is full; the message is dropped
+ */
+int chat_display_post(uint32_t sender, const char *msg, size_t len);
+
+/**
+ * @brief   Records the time taken by the /chat handler
+ */
+void chat_display_handler_time(uint32_t us);
+
+/**
+ * @brief   Prints display and handler statistics
+ */
+void chat_display_stats(void);
+
+/**
+ * @brief   Initializes the chat log
+ *
+ * @param[in] resource  the /chat/log resource, for notifications
+ */
+void chat_log_init(const coap_resource_t *resource);
+
+/**
+ * @brief   Adds a message to the chat log, and notifies observers
+ *
+ * @return  sequence number of the message
+ */
+uint32_t chat_log_add(const char *msg, size_t len);
+
+/**
+ * @brief   Server callback for /chat/log
+ */
+ssize_t chat_log_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, void *ctx);
+
+/**
+ * @brief   Fetches messages from a remote /chat/log, and prints them
+ *
+ * @param[in] remote    server endpoint
+ * @param[in] seq       first sequence number to fetch
+ *
+ * @return  0 on success
+ * @return  -1 on failure
+ */
+int chat_log_fetch(sock_udp_ep_t *remote, uint32_t seq);
+
+/**
+ * @brief   Shell handler for 'chat sub|unsub|log'
+ */
+int chat_sub_cmd(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* COAP_CHAT_H */
+/** @} */
@@ -0,0 +1,360 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - peer discovery
+ *
+ * Periodically sends a multicast GET for /.well-known/core to ff02::1. Each peer
+ * that lists /chat then is asked for its nickname, with a GET for /chat. The
+ * nicknames are kept in a table of their own, so a message may be sent to a
+ * nickname without parsing an address. The table is apart from the peer
+ * statistics, so a discovery round does not replace a peer in use for sending.
+ *
+ * gcoap drops a response from an address other than the request's destination,
+ * so discovery uses its own socket and thread, like the log subscriber.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+#include "net/nanocoap_sock.h"
+#include "net/sock/udp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Time to collect responses to the multicast request */
+#ifndef CHAT_DISCOVERY_LEISURE_MS
+#define CHAT_DISCOVERY_LEISURE_MS   (2000U)
+#endif
+
+/* Delay before the first discovery, for address autoconfiguration */
+#define DISC_START_DELAY    (5U * US_PER_SEC)
+#define DISC_TOKENLEN       (4U)
+#define DISC_MSG_TYPE       (0x4302)
+/* An entry expires after this many intervals without a response */
+#define DISC_EXPIRE_COUNT   (3U)
+
+static char _nick[CHAT_NICK_MAX];
+static kernel_pid_t _disc_pid = KERNEL_PID_UNDEF;
+static msg_t _disc_queue[2];
+static char _disc_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+
+/* Responders that list /chat, from one discovery round */
+static sock_udp_ep_t _found[CHAT_PEERS_MAX];
+
+/* A peer with a nickname, from discovery */
+typedef struct {
+    sock_udp_ep_t remote;
+    char nick[CHAT_NICK_MAX];   /* empty if unused */
+    uint32_t seen;              /* time of last response, in seconds */
+} _nick_entry_t;
+
+/* Nicknames, shared between the discovery and shell threads */
+static _nick_entry_t _nicks[CHAT_PEERS_MAX];
+static mutex_t _nicks_lock = MUTEX_INIT;
+
+/* Returns true if a link-format payload includes the /chat resource. */
+static bool _has_chat(const uint8_t *payload, size_t len)
+{
+    static const char link[] = "</chat>";
+    const size_t link_len = sizeof(link) - 1;
+
+    for (size_t i = 0; i + link_len <= len; i++) {
+        if (memcmp(&payload[i], link, link_len) == 0
+                && (i + link_len == len || payload[i + link_len] == ','
+                    || payload[i + link_len] == ';')) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Returns true if addr is one of our own addresses on netif. */
+static bool _is_local(gnrc_netif_t *netif, sock_udp_ep_t *ep)
+{
+    return gnrc_netif_ipv6_addr_idx(netif, (ipv6_addr_t *)ep->addr.ipv6) >= 0;
+}
+
+/*
+ * Sends the multicast request, and collects the peers with /chat into _found.
+ * Returns the count of peers found.
+ */
+static unsigned _find_peers(gnrc_netif_t *netif)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    uint8_t token[DISC_TOKENLEN];
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = {
+        .family = AF_INET6,
+        .netif = netif->pid,
+        .port = GCOAP_PORT,
+    };
+    sock_udp_t sock;
+    unsigned count = 0;
+
+    memcpy(remote.addr.ipv6, &ipv6_addr_all_nodes_link_local,
+           sizeof(remote.addr.ipv6));
+    local.netif = netif->pid;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        DEBUG("[CoAP] disc: unable to create socket\n");
+        return 0;
+    }
+
+    uint32_t token_val = random_uint32();
+    memcpy(token, &token_val, DISC_TOKENLEN);
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                             DISC_TOKENLEN, COAP_METHOD_GET, random_uint32());
+    bufpos += coap_opt_put_uri_path(bufpos, 0, "/.well-known/core");
+
+    uint32_t start = xtimer_now_usec();
+    if (sock_udp_send(&sock, buf, bufpos - buf, &remote) < 0) {
+        DEBUG("[CoAP] disc: send failed\n");
+        sock_udp_close(&sock);
+        return 0;
+    }
+
+    uint32_t leisure_us = CHAT_DISCOVERY_LEISURE_MS * US_PER_MS;
+    for (;;) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if (elapsed >= leisure_us) {
+            break;
+        }
+
+        sock_udp_ep_t src;
+        coap_pkt_t pdu;
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf),
+                                    leisure_us - elapsed, &src);
+        if (res <= 0) {
+            continue;
+        }
+        if (coap_parse(&pdu, buf, res) < 0
+                || coap_get_code_class(&pdu) != COAP_CLASS_SUCCESS
+                || coap_get_token_len(&pdu) != DISC_TOKENLEN
+                || memcmp(pdu.token, token, DISC_TOKENLEN) != 0
+                || !_has_chat(pdu.payload, pdu.payload_len)
+                || _is_local(netif, &src)) {
+            continue;
+        }
+        if (src.netif == SOCK_ADDR_ANY_NETIF) {
+            src.netif = netif->pid;
+        }
+
+        unsigned i;
+        for (i = 0; i < count; i++) {
+            if (memcmp(_found[i].addr.ipv6, src.addr.ipv6,
+                       sizeof(src.addr.ipv6)) == 0) {
+                break;
+            }
+        }
+        if (i == count && count < CHAT_PEERS_MAX) {
+            _found[count++] = src;
+        }
+    }
+    sock_udp_close(&sock);
+    return count;
+}
+
+/*
+ * Records a peer's nickname. Clears the nickname from any other entry, since a
+ * peer may have changed address. Replaces the entry seen longest ago if the
+ * table is full.
+ */
+static void _nick_add(const sock_udp_ep_t *remote, const char *nick, size_t len)
+{
+    _nick_entry_t *entry = NULL;
+
+    mutex_lock(&_nicks_lock);
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        _nick_entry_t *cur = &_nicks[i];
+        bool same_addr = memcmp(cur->remote.addr.ipv6, remote->addr.ipv6,
+                                sizeof(remote->addr.ipv6)) == 0;
+        if (cur->nick[0] && !same_addr && strncmp(cur->nick, nick, len) == 0
+                && cur->nick[len] == '\0') {
+            cur->nick[0] = '\0';
+        }
+        if (same_addr && cur->nick[0]) {
+            entry = cur;
+        }
+    }
+    for (unsigned i = 0; !entry && i < CHAT_PEERS_MAX; i++) {
+        if (!_nicks[i].nick[0]) {
+            entry = &_nicks[i];
+        }
+    }
+    if (!entry) {
+        entry = &_nicks[0];
+        for (unsigned i = 1; i < CHAT_PEERS_MAX; i++) {
+            if (_nicks[i].seen < entry->seen) {
+                entry = &_nicks[i];
+            }
+        }
+    }
+    entry->remote = *remote;
+    memcpy(entry->nick, nick, len);
+    entry->nick[len] = '\0';
+    entry->seen = xtimer_now_usec64() / US_PER_SEC;
+    mutex_unlock(&_nicks_lock);
+}
+
+/* Clears nicknames not refreshed within max_age seconds. */
+static void _nick_expire(uint32_t max_age)
+{
+    uint32_t now = xtimer_now_usec64() / US_PER_SEC;
+
+    mutex_lock(&_nicks_lock);
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        if (_nicks[i].nick[0] && now - _nicks[i].seen > max_age) {
+            _nicks[i].nick[0] = '\0';
+        }
+    }
+    mutex_unlock(&_nicks_lock);
+}
+
+/* Asks a peer for its nickname, and records it. */
+static void _get_nick(sock_udp_ep_t *remote)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    coap_pkt_t pdu;
+
+    pdu.hdr = (coap_hdr_t *)buf;
+    bufpos += coap_build_hdr(pdu.hdr, COAP_TYPE_CON, NULL, 0, COAP_METHOD_GET,
+                             random_uint32());
+    bufpos += coap_opt_put_uri_path(bufpos, 0, "/chat");
+    pdu.payload = bufpos;
+    pdu.payload_len = 0;
+
+    ssize_t res = nanocoap_request(&pdu, NULL, remote, sizeof(buf));
+    if (res < 0 || coap_get_code_raw(&pdu) != COAP_CODE_CONTENT
+            || pdu.payload_len == 0 || pdu.payload_len >= CHAT_NICK_MAX) {
+        DEBUG("[CoAP] disc: no nickname from peer\n");
+        return;
+    }
+    _nick_add(remote, (char *)pdu.payload, pdu.payload_len);
+}
+
+static void _discover(void)
+{
+    /* multicast to the first interface only */
+    gnrc_netif_t *netif = gnrc_netif_iter(NULL);
+    if (!netif) {
+        return;
+    }
+
+    unsigned count = _find_peers(netif);
+    DEBUG("[CoAP] disc: %u peers\n", count);
+    for (unsigned i = 0; i < count; i++) {
+        _get_nick(&_found[i]);
+    }
+    _nick_expire(DISC_EXPIRE_COUNT * CHAT_DISCOVERY_INTERVAL);
+}
+
+static void *_disc_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg;
+    uint32_t timeout = DISC_START_DELAY;
+
+    msg_init_queue(_disc_queue, sizeof(_disc_queue) / sizeof(_disc_queue[0]));
+
+    for (;;) {
+        /* a message triggers discovery early */
+        xtimer_msg_receive_timeout(&msg, timeout);
+        _discover();
+        timeout = CHAT_DISCOVERY_INTERVAL * US_PER_SEC;
+    }
+    return NULL;
+}
+
+void chat_discover_init(void)
+{
+    _disc_pid = thread_create(_disc_stack, sizeof(_disc_stack),
+                              THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                              _disc_thread, NULL, "chat_disc");
+}
+
+void chat_discover_now(void)
+{
+    msg_t msg = { .type = DISC_MSG_TYPE };
+
+    if (_disc_pid > KERNEL_PID_UNDEF) {
+        msg_try_send(&msg, _disc_pid);
+    }
+}
+
+int chat_discover_find(const char *nick, sock_udp_ep_t *remote)
+{
+    int res = -1;
+
+    mutex_lock(&_nicks_lock);
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        if (_nicks[i].nick[0] && strcmp(_nicks[i].nick, nick) == 0) {
+            /* a copy, so the entry may be replaced while we send */
+            *remote = _nicks[i].remote;
+            res = 0;
+            break;
+        }
+    }
+    mutex_unlock(&_nicks_lock);
+    return res;
+}
+
+void chat_discover_list(void)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    uint32_t now = xtimer_now_usec64() / US_PER_SEC;
+
+    puts("discovered nick  peer                                     age s");
+    mutex_lock(&_nicks_lock);
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        _nick_entry_t *entry = &_nicks[i];
+        if (!entry->nick[0]) {
+            continue;
+        }
+        ipv6_addr_to_str(addr_str, (ipv6_addr_t *)entry->remote.addr.ipv6,
+                         sizeof(addr_str));
+        printf("%-16s %-40s %5lu\n", entry->nick, addr_str,
+               (unsigned long)(now - entry->seen));
+    }
+    mutex_unlock(&_nicks_lock);
+}
+
+const char *chat_nick(void)
+{
+    return _nick;
+}
+
+int chat_nick_set(const char *nick)
+{
+    if (strlen(nick) >= CHAT_NICK_MAX) {
+        return -1;
+    }
+    strcpy(_nick, nick);
+    return 0;
+}
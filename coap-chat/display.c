@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - display thread for received messages
+ *
+ * The /chat handler runs in the gcoap thread, so printing to a slow console
+ * there delays the response and every other CoAP exchange. Instead the handler
+ * copies each message into a ring buffer, and a display thread prints it.
+ * The ring has a single producer and a single consumer, so it needs no lock.
+ * If the ring is full, the message is dropped and counted.
+ *
+ * Build with CHAT_DISPLAY_INLINE defined to print in the handler instead, for
+ * comparison of handler latency.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "msg.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define DISPLAY_MSG_TYPE_WAKE   (0x4301)
+
+typedef struct {
+    uint32_t time_us;           /* when received */
+    uint32_t sender;            /* sender ID from tag, or 0 */
+    uint8_t len;
+    char msg[CHAT_MSG_MAX];
+} display_entry_t;
+
+static display_entry_t _ring[CHAT_DISPLAY_QUEUE_SIZE];
+static volatile unsigned _head;     /* written only by the gcoap thread */
+static volatile unsigned _tail;     /* written only by the display thread */
+static kernel_pid_t _display_pid = KERNEL_PID_UNDEF;
+
+/* statistics */
+static uint32_t _dropped;
+static uint32_t _handled;
+static uint32_t _handler_us_total;
+static uint32_t _handler_us_max;
+
+static char _display_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+
+static void _print(const display_entry_t *entry)
+{
+    uint32_t ms = entry->time_us / US_PER_MS;
+
+    printf("\n[ CHAT %lu.%03lu", (unsigned long)(ms / 1000),
+           (unsigned long)(ms % 1000));
+    if (entry->sender) {
+        printf(" %08lx", (unsigned long)entry->sender);
+    }
+    printf(" ] %.*s\n\n", entry->len, entry->msg);
+}
+
+static void *_display_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg_queue[2];
+    msg_init_queue(msg_queue, 2);
+
+    while (1) {
+        msg_t msg;
+        msg_receive(&msg);
+
+        /* drain everything; wakeups may have been merged */
+        while (_tail != _head) {
+            _print(&_ring[_tail % CHAT_DISPLAY_QUEUE_SIZE]);
+            _tail++;
+        }
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+void chat_display_init(void)
+{
+#ifndef CHAT_DISPLAY_INLINE
+    _display_pid = thread_create(_display_stack, sizeof(_display_stack),
+                                 THREAD_PRIORITY_MAIN + 1, THREAD_CREATE_STACKTEST,
+                                 _display_thread, NULL, "chat_display");
+#endif
+}
+
+int chat_display_post(uint32_t sender, const char *msg, size_t len)
+{
+    display_entry_t entry = { .time_us = xtimer_now_usec(), .sender = sender };
+
+    if (len > CHAT_MSG_MAX) {
+        len = CHAT_MSG_MAX;
+    }
+    entry.len = len;
+    memcpy(entry.msg, msg, len);
+
+#ifdef CHAT_DISPLAY_INLINE
+    _print(&entry);
+    return 0;
+#else
+    if (_head - _tail >= CHAT_DISPLAY_QUEUE_SIZE) {
+        _dropped++;
+        return -1;
+    }
+    _ring[_head % CHAT_DISPLAY_QUEUE_SIZE] = entry;
+    _head++;
+
+    /* if the wakeup queue is full, the display thread is awake anyway */
+    msg_t wake = { .type = DISPLAY_MSG_TYPE_WAKE };
+    msg_try_send(&wake, _display_pid);
+    return 0;
+#endif
+}
+
+void chat_display_handler_time(uint32_t us)
+{
+    _handled++;
+    _handler_us_total += us;
+    if (us > _handler_us_max) {
+        _handler_us_max = us;
+    }
+}
+
+void chat_display_stats(void)
+{
+    printf("display: %s, %lu dropped, %u queued\n",
+#ifdef CHAT_DISPLAY_INLINE
+           "inline",
+#else
+           "thread",
+#endif
+           (unsigned long)_dropped, _head - _tail);
+    printf("handler: %lu msgs, mean %lu us, max %lu us\n",
+           (unsigned long)_handled,
+           (unsigned long)(_handled ? _handler_us_total / _handled : 0),
+           (unsigned long)_handler_us_max);
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - multicast groups and duplicate suppression
+ *
+ * A message is tagged with the sender's random ID and a sequence number, in a
+ * "m=<sender>-<seq>" Uri-Query. The sequence is shared by all destinations, so
+ * a tag is unique to one message. A receiver keeps a small cache of recently
+ * seen tags, and drops a message already seen. The tag is in the message
+ * itself, since a gcoap request handler does not see the source address.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fmt.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+#include "random.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define CHAT_TAG_PREFIX     "m="
+
+typedef struct {
+    uint32_t sender;
+    uint32_t seq;
+} chat_tag_t;
+
+static uint32_t _sender_id;
+static uint32_t _last_seq;
+
+/* Cache of recently seen tags, replaced oldest first */
+static chat_tag_t _seen[CHAT_DEDUP_SIZE];
+static unsigned _seen_next;
+static unsigned _seen_count;
+static uint32_t _dups;
+
+void chat_group_init(void)
+{
+    _sender_id = random_uint32();
+}
+
+size_t chat_tag_write(char *buf)
+{
+    size_t len = strlen(CHAT_TAG_PREFIX);
+
+    memcpy(buf, CHAT_TAG_PREFIX, len);
+    len += fmt_u32_hex(&buf[len], _sender_id);
+    buf[len++] = '-';
+    len += fmt_u32_dec(&buf[len], ++_last_seq);
+    return len;
+}
+
+int chat_tag_seen(const uint8_t *tag, size_t len, uint32_t *sender)
+{
+    char tag_str[CHAT_TAG_MAX + 1];
+    size_t prefix_len = strlen(CHAT_TAG_PREFIX);
+    char *end;
+
+    *sender = 0;
+    if (len <= prefix_len || len > CHAT_TAG_MAX
+            || memcmp(tag, CHAT_TAG_PREFIX, prefix_len) != 0) {
+        /* not tagged; can't tell */
+        return 0;
+    }
+    memcpy(tag_str, tag, len);
+    tag_str[len] = '\0';
+
+    chat_tag_t entry;
+    entry.sender = strtoul(&tag_str[prefix_len], &end, 16);
+    if (*end != '-') {
+        return 0;
+    }
+    entry.seq = strtoul(end + 1, NULL, 10);
+    *sender = entry.sender;
+
+    for (unsigned i = 0; i < _seen_count; i++) {
+        if (_seen[i].sender == entry.sender && _seen[i].seq == entry.seq) {
+            _dups++;
+            return 1;
+        }
+    }
+    _seen[_seen_next] = entry;
+    _seen_next = (_seen_next + 1) % CHAT_DEDUP_SIZE;
+    if (_seen_count < CHAT_DEDUP_SIZE) {
+        _seen_count++;
+    }
+    return 0;
+}
+
+uint32_t chat_group_dups(void)
+{
+    return _dups;
+}
+
+int chat_group_cmd(int argc, char **argv)
+{
+    ipv6_addr_t addr;
+    kernel_pid_t iface;
+
+    if (argc != 3) {
+        goto usage;
+    }
+    bool join = (strcmp(argv[1], "join") == 0);
+
+    iface = ipv6_addr_split_iface(argv[2]);
+    if (iface == -1) {
+        if (gnrc_netif_numof() != 1) {
+            puts("must specify interface, like ff05::1%6");
+            return 1;
+        }
+        iface = gnrc_netif_iter(NULL)->pid;
+    }
+    if (ipv6_addr_from_str(&addr, argv[2]) == NULL
+            || !ipv6_addr_is_multicast(&addr)) {
+        puts("not a multicast address");
+        return 1;
+    }
+
+    netopt_t opt = join ? NETOPT_IPV6_GROUP : NETOPT_IPV6_GROUP_LEAVE;
+    if (gnrc_netapi_set(iface, opt, 0, &addr, sizeof(addr)) < 0) {
+        printf("unable to %s group\n", argv[1]);
+        return 1;
+    }
+    return 0;
+
+    usage:
+    puts("usage: chat join|leave <group>[%iface]");
+    return 1;
+}
@@ -19,33 +19,68 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 #include "msg.h"
 
 #include "net/gcoap.h"
 #include "kernel_types.h"
 #include "shell.h"
 
-#define BUFLEN          (64U)
+#include "coap_chat.h"
+
 #define MAIN_QUEUE_SIZE (4)
 
 static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
 
-extern int coap_post(const char *addr, const char *buf, size_t buflen);
-extern void coap_init(void);
-
 int chat(int argc, char **argv)
 {
-    if (argc < 4) {
-        puts("usage: chat <addr> <nick> <msg>");
-        return 1;
+    if (argc > 1 && (strcmp(argv[1], "sub") == 0
+                     || strcmp(argv[1], "unsub") == 0
+                     || strcmp(argv[1], "log") == 0)) {
+        return chat_sub_cmd(argc, argv);
+    }
+    if (argc == 2 && strcmp(argv[1], "display") == 0) {
+        chat_display_stats();
+        return 0;
+    }
+    if (argc > 1 && (strcmp(argv[1], "join") == 0
+                     || strcmp(argv[1], "leave") == 0)) {
+        return chat_group_cmd(argc, argv);
+    }
+    if (argc == 2 && strcmp(argv[1], "stats") == 0) {
+        chat_peer_stats();
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "discover") == 0) {
+        chat_discover_now();
+        return 0;
+    }
+    if ((argc == 2 || argc == 3) && strcmp(argv[1], "nick") == 0) {
+        if (argc == 3 && chat_nick_set(argv[2]) < 0) {
+            puts("nickname too long");
+            return 1;
+        }
+        printf("nick: %s\n", chat_nick());
+        return 0;
     }
 
-    char buf[BUFLEN] = { 0 };
-    size_t len = snprintf(buf, BUFLEN, "%s: %s", argv[2], argv[3]);
-    for (int i = 4; i < argc; ++i) {
-        len += snprintf(buf + len, BUFLEN - len, " %s", argv[i]);
+    int apos = 1;
+    bool confirmable = false;
+    if (argc > apos && strcmp(argv[apos], "-c") == 0) {
+        confirmable = true;
+        apos++;
     }
-    coap_post(argv[1], buf, len);
+    if (argc < apos + 3) {
+        puts("usage: chat [-c] <addr|peer nick> <nick> <msg>");
+        puts("       chat stats|display|discover");
+        puts("       chat nick [<nick>]");
+        puts("       chat join|leave <group>");
+        puts("       chat sub <addr> | chat unsub | chat log <addr> [seq]");
+        return 1;
+    }
+
+    coap_post(argv[apos], argv[apos+1], &argv[apos+2], argc - apos - 2,
+              confirmable);
 
     return 0;
 }
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - peer table with delivery statistics
+ *
+ * Counts the fate of each message sent to a unicast peer. A request is matched
+ * to its response by token. When the table is full, the least recently used
+ * peer is replaced. Entries are private to this file, and used only with the
+ * lock held, so replacing one can't pull it from under another thread.
+ *
+ * gcoap retransmits a confirmable request internally, and does not report the
+ * count. So a response later than the initial ACK timeout is counted as
+ * 'retried'.
+ *
+ * A request is recorded before it is sent, since gcoap may handle its response
+ * before the send returns. A pending request which is never matched is freed
+ * after the CoAP exchange lifetime, so it can't hold a slot forever; it then
+ * counts as neither delivered nor failed.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "xtimer.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Requests awaiting a response */
+#define PENDING_MAX         (GCOAP_REQ_WAITING_MAX)
+
+/* EXCHANGE_LIFETIME from RFC 7252, with the default transmission parameters */
+#define PENDING_LIFETIME_US (247U * US_PER_SEC)
+
+/* A peer, with delivery statistics */
+typedef struct {
+    bool in_use;
+    sock_udp_ep_t remote;
+    uint32_t used;              /* last use, for LRU replacement */
+    uint32_t sent;
+    uint32_t delivered;         /* acknowledged by success */
+    uint32_t failed;            /* timeouts and error responses */
+    uint32_t retried;           /* delivered after the ACK timeout */
+    uint32_t latency_us_total;
+    uint32_t latency_us_max;
+} chat_peer_t;
+
+typedef struct {
+    chat_peer_t *peer;          /* NULL if unused */
+    bool confirmable;
+    uint8_t token_len;
+    uint8_t token[GCOAP_TOKENLEN];
+    uint32_t sent_us;
+} _pending_t;
+
+static chat_peer_t _peers[CHAT_PEERS_MAX];
+static uint32_t _use_count;     /* orders entries by last use */
+static _pending_t _pending[PENDING_MAX];
+static mutex_t _lock = MUTEX_INIT;
+
+static bool _ep_equal(const sock_udp_ep_t *a, const sock_udp_ep_t *b)
+{
+    return (a->netif == b->netif) && (a->port == b->port)
+           && (memcmp(a->addr.ipv6, b->addr.ipv6, sizeof(a->addr.ipv6)) == 0);
+}
+
+/* Records the outcome for a message; call with _lock held. */
+static void _record(chat_peer_t *peer, bool ok, bool confirmable,
+                    uint32_t latency)
+{
+    if (!ok) {
+        peer->failed++;
+        return;
+    }
+    peer->delivered++;
+    peer->latency_us_total += latency;
+    if (latency > peer->latency_us_max) {
+        peer->latency_us_max = latency;
+    }
+    if (confirmable && latency > COAP_ACK_TIMEOUT * US_PER_SEC) {
+        peer->retried++;
+    }
+}
+
+/* Finds the entry for a peer, or adds it; call with _lock held. */
+static chat_peer_t *_get(const sock_udp_ep_t *remote)
+{
+    chat_peer_t *peer = NULL;
+
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        if (_peers[i].in_use && _ep_equal(&_peers[i].remote, remote)) {
+            peer = &_peers[i];
+            break;
+        }
+    }
+    if (!peer) {
+        /* an unused entry, or else the least recently used */
+        peer = &_peers[0];
+        for (unsigned i = 1; i < CHAT_PEERS_MAX && peer->in_use; i++) {
+            if (!_peers[i].in_use || _peers[i].used < peer->used) {
+                peer = &_peers[i];
+            }
+        }
+        for (unsigned i = 0; i < PENDING_MAX; i++) {
+            if (_pending[i].peer == peer) {
+                _pending[i].peer = NULL;
+            }
+        }
+        memset(peer, 0, sizeof(*peer));
+        peer->in_use = true;
+        peer->remote = *remote;
+    }
+    peer->used = ++_use_count;
+    return peer;
+}
+
+void chat_peer_sent(const sock_udp_ep_t *remote, const coap_pkt_t *pdu,
+                    bool confirmable)
+{
+    _pending_t *pending = NULL;
+    uint32_t now = xtimer_now_usec();
+
+    mutex_lock(&_lock);
+    chat_peer_t *peer = _get(remote);
+    peer->sent++;
+    for (unsigned i = 0; i < PENDING_MAX; i++) {
+        if (!_pending[i].peer
+                || (now - _pending[i].sent_us) > PENDING_LIFETIME_US) {
+            pending = &_pending[i];
+            break;
+        }
+    }
+    if (pending) {
+        pending->peer = peer;
+        pending->confirmable = confirmable;
+        pending->token_len = coap_get_token_len(pdu);
+        memcpy(pending->token, coap_hdr_data_ptr(pdu->hdr), pending->token_len);
+        pending->sent_us = now;
+    }
+    mutex_unlock(&_lock);
+}
+
+/* Finds the pending request for a token; call with _lock held. */
+static _pending_t *_find(const coap_pkt_t *pdu)
+{
+    unsigned token_len = coap_get_token_len(pdu);
+    uint8_t *token = coap_hdr_data_ptr(pdu->hdr);
+
+    for (unsigned i = 0; i < PENDING_MAX; i++) {
+        _pending_t *pending = &_pending[i];
+        if (pending->peer && pending->token_len == token_len
+                && memcmp(pending->token, token, token_len) == 0) {
+            return pending;
+        }
+    }
+    return NULL;
+}
+
+void chat_peer_unsent(const coap_pkt_t *pdu)
+{
+    mutex_lock(&_lock);
+    _pending_t *pending = _find(pdu);
+    if (pending) {
+        pending->peer->sent--;
+        pending->peer = NULL;
+    }
+    mutex_unlock(&_lock);
+}
+
+void chat_peer_resp(unsigned req_state, coap_pkt_t *pdu)
+{
+    uint32_t now = xtimer_now_usec();
+    bool ok = (req_state == GCOAP_MEMO_RESP)
+              && (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS);
+
+    mutex_lock(&_lock);
+    _pending_t *pending = _find(pdu);
+    if (pending) {
+        _record(pending->peer, ok, pending->confirmable,
+                now - pending->sent_us);
+        pending->peer = NULL;
+    }
+    mutex_unlock(&_lock);
+}
+
+void chat_peer_done(const sock_udp_ep_t *remote, bool ok, uint32_t latency)
+{
+    mutex_lock(&_lock);
+    chat_peer_t *peer = _get(remote);
+    peer->sent++;
+    _record(peer, ok, true, latency);
+    mutex_unlock(&_lock);
+}
+
+void chat_peer_stats(void)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+
+    puts("peer                                     sent   ok fail retried "
+         "mean ms max ms");
+    mutex_lock(&_lock);
+    for (unsigned i = 0; i < CHAT_PEERS_MAX; i++) {
+        chat_peer_t *peer = &_peers[i];
+        if (!peer->in_use) {
+            continue;
+        }
+        ipv6_addr_to_str(addr_str, (ipv6_addr_t *)peer->remote.addr.ipv6,
+                         sizeof(addr_str));
+        uint32_t mean = peer->delivered
+                        ? peer->latency_us_total / peer->delivered : 0;
+        printf("%-40s %4lu %4lu %4lu %7lu %7lu %6lu\n", addr_str,
+               (unsigned long)peer->sent, (unsigned long)peer->delivered,
+               (unsigned long)peer->failed, (unsigned long)peer->retried,
+               (unsigned long)(mean / US_PER_MS),
+               (unsigned long)(peer->latency_us_max / US_PER_MS));
+    }
+    mutex_unlock(&_lock);
+    printf("duplicates dropped: %lu\n", (unsigned long)chat_group_dups());
+    chat_discover_list();
+}
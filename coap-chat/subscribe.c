@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     applications
+ * @{
+ *
+ * @file
+ * @brief       coap-chat - subscription to a remote /chat/log
+ *
+ * 'chat sub' follows a peer's conversation. The peer's /chat/log is observable,
+ * and its representation is the latest message, as "<seq> <text>". A peer keeps
+ * sending notifications for as long as we follow, while a gcoap request ends
+ * with its first response, so the subscriber has its own socket and thread.
+ *
+ * Notifications are non-confirmable as a rule, so one may be lost. The message
+ * sequence number shows the gap, and the subscriber fetches the missed
+ * messages from the log with a blockwise GET.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gcoap.h"
+#include "net/sock/udp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "coap_chat.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define SUB_TOKENLEN        (4U)
+/* Poll interval for 'chat unsub' while following */
+#define SUB_RECV_TIMEOUT    (1U * US_PER_SEC)
+#define SUB_OBS_REGISTER    (0U)
+#define SUB_OBS_DEREGISTER  (1U)
+
+/* Subscription states */
+typedef enum {
+    SUB_JOINING,            /* registration sent, no notification yet */
+    SUB_FOLLOWING,          /* printing notifications */
+    SUB_LEAVING,            /* deregistration sent */
+} _sub_state_t;
+
+static struct {
+    volatile bool running;
+    volatile bool stop;
+    sock_udp_ep_t remote;
+    uint8_t token[SUB_TOKENLEN];
+    uint16_t msgid;
+    uint32_t last_seq;
+} _sub;
+
+static char _sub_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+
+/*
+ * Sends a confirmable GET for /chat/log with the provided Observe value, and
+ * message ID, so a retransmission may reuse it.
+ */
+static int _send_get(sock_udp_t *sock, unsigned observe, uint16_t msgid)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    uint8_t obs_val = observe;
+
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, _sub.token,
+                             SUB_TOKENLEN, COAP_METHOD_GET, msgid);
+    /* value 0 is encoded as an empty option */
+    bufpos += coap_put_option(bufpos, 0, COAP_OPT_OBSERVE, &obs_val,
+                              observe ? 1 : 0);
+    bufpos += coap_opt_put_uri_path(bufpos, COAP_OPT_OBSERVE, "/chat/log");
+
+    return sock_udp_send(sock, buf, bufpos - buf, &_sub.remote);
+}
+
+/* Sends an empty ACK or RST for a confirmable message. */
+static void _send_empty(sock_udp_t *sock, unsigned type, coap_pkt_t *pdu,
+                        sock_udp_ep_t *remote)
+{
+    uint8_t buf[sizeof(coap_hdr_t)];
+
+    coap_build_hdr((coap_hdr_t *)buf, type, NULL, 0, COAP_CODE_EMPTY,
+                   coap_get_id(pdu));
+    sock_udp_send(sock, buf, sizeof(buf), remote);
+}
+
+/* Prints a "<seq> <msg>" notification, after any messages missed. */
+static void _handle_notification(coap_pkt_t *pdu)
+{
+    if (pdu->payload_len == 0) {
+        /* log empty */
+        return;
+    }
+    char *msg = NULL;
+    uint32_t seq = strtoul((char *)pdu->payload, &msg, 10);
+    if (msg == (char *)pdu->payload || *msg != ' ') {
+        DEBUG("[CoAP] sub: can't parse notification\n");
+        return;
+    }
+    if (_sub.last_seq && seq <= _sub.last_seq) {
+        /* old or reordered */
+        return;
+    }
+
+    if (_sub.last_seq && seq > _sub.last_seq + 1) {
+        printf("\n[ CHAT ] missed %lu, fetching from log\n",
+               (unsigned long)(seq - _sub.last_seq - 1));
+        chat_log_fetch(&_sub.remote, _sub.last_seq + 1);
+    }
+    else {
+        msg++;
+        int len = pdu->payload_len - (msg - (char *)pdu->payload);
+        printf("\n[ CHAT ] %.*s\n\n", len, msg);
+    }
+    _sub.last_seq = seq;
+}
+
+static void *_sub_thread(void *arg)
+{
+    (void)arg;
+    sock_udp_t sock;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    _sub_state_t state = SUB_JOINING;
+
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("[CoAP] sub: unable to create socket");
+        _sub.running = false;
+        return NULL;
+    }
+
+    /* until the peer answers, resend the registration with back-off */
+    uint16_t join_msgid = _sub.msgid++;
+    uint32_t join_timeout = COAP_ACK_TIMEOUT * US_PER_SEC;
+    unsigned join_sends = 1;
+    bool join_acked = false;
+
+    if (_send_get(&sock, SUB_OBS_REGISTER, join_msgid) < 0) {
+        puts("[CoAP] sub: registration send failed");
+        goto exit;
+    }
+
+    while (1) {
+        sock_udp_ep_t remote;
+        coap_pkt_t pdu;
+
+        if (_sub.stop && state != SUB_LEAVING) {
+            /* tell the peer, rather than wait to reject its next notification */
+            _send_get(&sock, SUB_OBS_DEREGISTER, _sub.msgid++);
+            state = SUB_LEAVING;
+        }
+        bool resend = (state == SUB_JOINING && !join_acked);
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf),
+                                    resend ? join_timeout : SUB_RECV_TIMEOUT,
+                                    &remote);
+        if (res == -ETIMEDOUT && resend) {
+            if (join_sends++ > COAP_MAX_RETRANSMIT) {
+                puts("[CoAP] sub: peer did not respond");
+                goto exit;
+            }
+            join_timeout *= 2;
+            _send_get(&sock, SUB_OBS_REGISTER, join_msgid);
+            continue;
+        }
+        if (res <= 0) {
+            if (state == SUB_LEAVING) {
+                /* no answer to the deregistration; leave anyway */
+                break;
+            }
+            continue;
+        }
+        if (coap_parse(&pdu, buf, res) < 0) {
+            continue;
+        }
+        if (coap_get_type(&pdu) == COAP_TYPE_ACK
+                && coap_get_code_raw(&pdu) == COAP_CODE_EMPTY) {
+            /* the peer will respond separately */
+            join_acked |= (coap_get_id(&pdu) == join_msgid);
+            continue;
+        }
+        if (coap_get_code_class(&pdu) == COAP_CLASS_REQ
+                || coap_get_token_len(&pdu) != SUB_TOKENLEN
+                || memcmp(pdu.token, _sub.token, SUB_TOKENLEN) != 0) {
+            DEBUG("[CoAP] sub: ignoring unexpected message\n");
+            continue;
+        }
+
+        if (state == SUB_LEAVING) {
+            /* a notification sent before the peer saw the deregistration */
+            if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+                _send_empty(&sock, COAP_TYPE_RST, &pdu, &remote);
+            }
+            if (!coap_has_observe(&pdu)) {
+                /* response to the deregistration */
+                break;
+            }
+            continue;
+        }
+
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            _send_empty(&sock, COAP_TYPE_ACK, &pdu, &remote);
+        }
+        if (!coap_has_observe(&pdu)) {
+            puts("[CoAP] sub: server did not accept subscription");
+            goto exit;
+        }
+        if (state == SUB_JOINING) {
+            puts("[ CHAT ] subscribed");
+            state = SUB_FOLLOWING;
+        }
+        _handle_notification(&pdu);
+    }
+
+    exit:
+    sock_udp_close(&sock);
+    _sub.running = false;
+    return NULL;
+}
+
+int chat_sub_cmd(int argc, char **argv)
+{
+    sock_udp_ep_t remote;
+
+    if (argc == 2 && strcmp(argv[1], "unsub") == 0) {
+        if (!_sub.running) {
+            puts("not subscribed");
+            return 1;
+        }
+        _sub.stop = true;
+        while (_sub.running) {
+            xtimer_usleep(100U * US_PER_MS);
+        }
+        return 0;
+    }
+
+    if (argc == 3 && strcmp(argv[1], "sub") == 0) {
+        if (_sub.running) {
+            puts("already subscribed; use 'chat unsub' first");
+            return 1;
+        }
+        memset(&_sub, 0, sizeof(_sub));
+        if (coap_chat_init_remote(&_sub.remote, argv[2]) < 0) {
+            puts("[CoAP] unable to parse address");
+            return 1;
+        }
+        _sub.msgid = random_uint32();
+        uint32_t token = random_uint32();
+        memcpy(_sub.token, &token, SUB_TOKENLEN);
+
+        _sub.running = true;
+        if (thread_create(_sub_stack, sizeof(_sub_stack),
+                          THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                          _sub_thread, NULL, "chat_sub") <= KERNEL_PID_UNDEF) {
+            puts("[CoAP] sub: unable to start thread");
+            _sub.running = false;
+            return 1;
+        }
+        return 0;
+    }
+
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "log") == 0) {
+        if (coap_chat_init_remote(&remote, argv[2]) < 0) {
+            puts("[CoAP] unable to parse address");
+            return 1;
+        }
+        uint32_t seq = (argc == 4) ? strtoul(argv[3], NULL, 10) : 0;
+        if (chat_log_fetch(&remote, seq) < 0) {
+            puts("[CoAP] log fetch failed");
+            return 1;
+        }
+        return 0;
+    }
+
+    puts("usage: chat sub <addr> | chat unsub | chat log <addr> [seq]");
+    return 1;
+}
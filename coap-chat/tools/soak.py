@@ -0,0 +1,287 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# Copyright (c) 2026 agent
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Soak test for coap-chat on the native board.
+
+Starts N native instances, each on its own tap interface of a tap bridge, and
+drives them from their shells. Each instance sends messages at a fixed rate to
+a random peer, or to all peers via ff02::1. The script matches each message to
+the '[ CHAT ... ]' line printed by its receiver, and measures:
+
+- end-to-end latency, from the write of the 'chat' command to the read of the
+  receiver's output; so it includes shell and pipe overhead
+- loss, as messages not received by the end of the drain period
+- CPU time per message, from /proc for all instances, divided by the count of
+  messages sent
+
+Appends a summary row for each run to a CSV file. Pass lists of node counts and
+rates to run a sweep. Optionally writes a row per message to a second CSV file.
+
+Build the application, and create the taps, with:
+
+    make BOARD=native
+    sudo ../RIOT/dist/tools/tapsetup/tapsetup -c 8
+
+Then run:
+
+    ./tools/soak.py bin/native/coap_chat.elf -n 2,4,8 -r 1,5,20 -o soak.csv
+'''
+
+import argparse
+import csv
+import os
+import random
+import re
+import subprocess
+import sys
+import threading
+import time
+
+CHAT_RE = re.compile(r'\[ CHAT [\d.]+(?: [0-9a-f]{8})? \] s(\d+): (\d+)')
+IFACE_RE = re.compile(r'Iface\s+(\d+)')
+LLADDR_RE = re.compile(r'inet6 addr: (fe80:[0-9a-f:]+)')
+
+SUMMARY_FIELDS = ['nodes', 'rate', 'mode', 'size', 'sent', 'expected',
+                  'received', 'loss_pct', 'p50_ms', 'p90_ms', 'p99_ms',
+                  'max_ms', 'cpu_ms_per_msg']
+
+CLK_TCK = os.sysconf('SC_CLK_TCK')
+
+
+class Node(object):
+    '''A native coap-chat instance, driven through its shell'''
+
+    def __init__(self, index, elf, tap, received):
+        self.index = index
+        self.received = received
+        self.lock = threading.Lock()
+        self.lines = []
+        self.proc = subprocess.Popen([elf, tap], stdin=subprocess.PIPE,
+                                     stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT,
+                                     universal_newlines=True, bufsize=1)
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+        self.iface = None
+        self.addr = None
+
+    def _read(self):
+        for line in self.proc.stdout:
+            now = time.monotonic()
+            match = CHAT_RE.search(line)
+            if match:
+                key = (int(match.group(1)), int(match.group(2)), self.index)
+                self.received.setdefault(key, now)
+                continue
+            with self.lock:
+                if self.lines is not None:
+                    self.lines.append(line)
+
+    def cmd(self, line):
+        self.proc.stdin.write(line + '\n')
+        self.proc.stdin.flush()
+
+    def wait_for(self, regex, timeout):
+        '''Returns first match of regex in output, or None on timeout'''
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            with self.lock:
+                for line in self.lines:
+                    match = regex.search(line)
+                    if match:
+                        return match
+            time.sleep(0.1)
+        return None
+
+    def resolve(self, timeout):
+        '''Reads interface and link-local address from ifconfig'''
+        with self.lock:
+            self.lines = []
+        self.cmd('ifconfig')
+        iface = self.wait_for(IFACE_RE, timeout)
+        addr = self.wait_for(LLADDR_RE, timeout)
+        if not iface or not addr:
+            return False
+        self.iface = iface.group(1)
+        self.addr = addr.group(1)
+        # stop collecting output
+        with self.lock:
+            self.lines = None
+        return True
+
+    def cpu_seconds(self):
+        with open('/proc/{}/stat'.format(self.proc.pid)) as stat:
+            # skip past the command name, which may contain spaces
+            fields = stat.read().rsplit(')', 1)[1].split()
+        return (int(fields[11]) + int(fields[12])) / CLK_TCK
+
+    def stop(self):
+        self.proc.terminate()
+        try:
+            self.proc.wait(timeout=2)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+
+
+def percentile(values, pct):
+    if not values:
+        return ''
+    index = min(len(values) - 1, int(len(values) * pct / 100))
+    return '{:.1f}'.format(values[index] * 1000)
+
+
+def run(args, count, rate, msg_writer):
+    received = {}
+    nodes = []
+    try:
+        for i in range(count):
+            nodes.append(Node(i, args.elf, '{}{}'.format(args.tap, i), received))
+        # let instances complete address autoconfiguration
+        time.sleep(args.settle)
+        for node in nodes:
+            if not node.resolve(5):
+                sys.exit('error: no link-local address for node {}'.format(node.index))
+
+        cpu_start = sum(node.cpu_seconds() for node in nodes)
+        confirm = '-c ' if args.confirmable else ''
+        filler = 'x' * args.size
+        sent = {}
+        interval = 1.0 / rate
+        start = time.monotonic()
+        # stagger senders across the interval
+        next_send = [start + interval * i / count for i in range(count)]
+        seq = [0] * count
+
+        while time.monotonic() < start + args.duration:
+            src = min(range(count), key=lambda i: next_send[i])
+            delay = next_send[src] - time.monotonic()
+            if delay > 0:
+                time.sleep(delay)
+            node = nodes[src]
+            seq[src] += 1
+            if args.multicast:
+                dst = 'ff02::1%{}'.format(node.iface)
+                expected = [n.index for n in nodes if n is not node]
+            else:
+                peer = random.choice([n for n in nodes if n is not node])
+                dst = '{}%{}'.format(peer.addr, node.iface)
+                expected = [peer.index]
+            sent[(src, seq[src])] = (time.monotonic(), expected)
+            node.cmd('chat {}{} s{} {} {}'.format(confirm, dst, src, seq[src],
+                                                  filler))
+            next_send[src] += interval
+
+        time.sleep(args.drain)
+        cpu = sum(node.cpu_seconds() for node in nodes) - cpu_start
+    finally:
+        for node in nodes:
+            node.stop()
+
+    latencies = []
+    expected_total = 0
+    for (src, num), (sent_at, expected) in sorted(sent.items()):
+        for dst in expected:
+            expected_total += 1
+            recv_at = received.get((src, num, dst))
+            if recv_at is not None:
+                latencies.append(recv_at - sent_at)
+            if msg_writer:
+                msg_writer.writerow([count, rate, src, dst, num,
+                                     '{:.6f}'.format(sent_at - start),
+                                     '' if recv_at is None else
+                                     '{:.3f}'.format((recv_at - sent_at) * 1000)])
+    latencies.sort()
+    lost = expected_total - len(latencies)
+
+    return {
+        'nodes': count,
+        'rate': rate,
+        'mode': (('mcast' if args.multicast else 'ucast')
+                 + ('-con' if args.confirmable else '')),
+        'size': args.size,
+        'sent': len(sent),
+        'expected': expected_total,
+        'received': len(latencies),
+        'loss_pct': ('{:.2f}'.format(100.0 * lost / expected_total)
+                     if expected_total else ''),
+        'p50_ms': percentile(latencies, 50),
+        'p90_ms': percentile(latencies, 90),
+        'p99_ms': percentile(latencies, 99),
+        'max_ms': percentile(latencies, 100),
+        'cpu_ms_per_msg': '{:.3f}'.format(cpu * 1000 / len(sent))
+                          if sent else '',
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='coap-chat soak test')
+    parser.add_argument('elf', help='native coap-chat binary')
+    parser.add_argument('-n', '--nodes', default='2',
+                        help='comma separated list of node counts; default 2')
+    parser.add_argument('-r', '--rate', default='1',
+                        help='comma separated list of messages per second '
+                             'per node; default 1')
+    parser.add_argument('-d', '--duration', type=float, default=30,
+                        help='seconds of sending per run; default 30')
+    parser.add_argument('-s', '--size', type=int, default=16,
+                        help='filler bytes per message; default 16')
+    parser.add_argument('-m', '--multicast', action='store_true',
+                        help='send to ff02::1 rather than a random peer')
+    parser.add_argument('-c', '--confirmable', action='store_true',
+                        help='send as CON; unicast only')
+    parser.add_argument('-t', '--tap', default='tap',
+                        help='tap interface prefix; default tap')
+    parser.add_argument('--settle', type=float, default=3,
+                        help='seconds to wait for addresses; default 3')
+    parser.add_argument('--drain', type=float, default=5,
+                        help='seconds to wait for late messages; default 5')
+    parser.add_argument('-o', '--output', default='soak.csv',
+                        help='summary CSV, appended; default soak.csv')
+    parser.add_argument('--messages', help='per message CSV, overwritten')
+    args = parser.parse_args()
+
+    if args.multicast and args.confirmable:
+        parser.error('a multicast message cannot be confirmable')
+
+    counts = [int(n) for n in args.nodes.split(',')]
+    rates = [float(r) for r in args.rate.split(',')]
+    if min(counts) < 2:
+        parser.error('need at least 2 nodes')
+    for i in range(max(counts)):
+        if not os.path.exists('/sys/class/net/{}{}'.format(args.tap, i)):
+            sys.exit('error: {}{} not found; create taps with tapsetup'
+                     .format(args.tap, i))
+
+    msg_file = open(args.messages, 'w', newline='') if args.messages else None
+    msg_writer = csv.writer(msg_file) if msg_file else None
+    if msg_writer:
+        msg_writer.writerow(['nodes', 'rate', 'src', 'dst', 'seq', 'sent_s',
+                             'latency_ms'])
+
+    new_file = not os.path.exists(args.output)
+    with open(args.output, 'a', newline='') as out:
+        writer = csv.DictWriter(out, fieldnames=SUMMARY_FIELDS)
+        if new_file:
+            writer.writeheader()
+        for count in counts:
+            for rate in rates:
+                result = run(args, count, rate, msg_writer)
+                writer.writerow(result)
+                out.flush()
+                print('{nodes} nodes at {rate}/s: {received}/{expected} '
+                      'received, loss {loss_pct}%, p50 {p50_ms} ms, '
+                      'p99 {p99_ms} ms, cpu {cpu_ms_per_msg} ms/msg'
+                      .format(**result))
+
+    if msg_file:
+        msg_file.close()
+
+
+if __name__ == '__main__':
+    main()
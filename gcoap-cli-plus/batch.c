@@ -0,0 +1,364 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI batch mode, with pipelined requests
+ *
+ * Reads request lines from a file on VFS, and keeps up to 'window' requests
+ * outstanding. Each line has the same form as the arguments to a 'coap'
+ * get/post/put command, like:
+ *
+ *     get -c fe80::2%6 5683 /riot/board
+ *     put fe80::2%6 5683 /cli/stats 0
+ *
+ * The request tracker matches responses to requests by token. When all
+ * responses are in, prints a table of the status and latency for each request.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#ifdef MODULE_VFS
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "vfs.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+#include "reqtrack.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Max requests in a batch file */
+#ifndef GCOAP_CLI_BATCH_MAX
+#define GCOAP_CLI_BATCH_MAX     (32U)
+#endif
+
+#define BATCH_LINE_MAX          (96U)
+#define BATCH_PATH_MAX          (24U)
+#define BATCH_WINDOW_MAX        (REQTRACK_SLOTS_MAX)
+
+/* Request states */
+enum {
+    BATCH_PENDING,
+    BATCH_DONE,
+    BATCH_TIMEOUT,
+    BATCH_ERR,
+    BATCH_SEND_FAILED,
+};
+
+typedef struct {
+    uint8_t state;
+    uint8_t method;
+    uint8_t code;               /* response code */
+    char path[BATCH_PATH_MAX];
+    uint32_t latency_us;
+} _batch_req_t;
+
+static const char *_method_names[] = { "get", "post", "put" };
+
+/* Batch state, shared between CLI and gcoap threads; track.lock guards */
+static struct {
+    reqtrack_t track;
+    unsigned count;
+    _batch_req_t reqs[GCOAP_CLI_BATCH_MAX];
+} _batch = { .track = { .lock = MUTEX_INIT } };
+
+/* Buffered line reader for a VFS file */
+static struct {
+    int fd;
+    char buf[64];
+    size_t pos;
+    size_t len;
+} _reader;
+
+/*
+ * Reads the next line into 'line', without the newline. Returns length of the
+ * line, -1 at end of file, or -2 if the line is longer than 'max' - 1.
+ */
+static int _read_line(char *line, size_t max)
+{
+    size_t len = 0;
+    bool eof = true;
+    bool too_long = false;
+
+    while (1) {
+        if (_reader.pos == _reader.len) {
+            ssize_t res = vfs_read(_reader.fd, _reader.buf, sizeof(_reader.buf));
+            if (res <= 0) {
+                break;
+            }
+            _reader.pos = 0;
+            _reader.len = res;
+        }
+        eof = false;
+        char c = _reader.buf[_reader.pos++];
+        if (c == '\n') {
+            break;
+        }
+        if (c == '\r') {
+            continue;
+        }
+        if (len < max - 1) {
+            line[len++] = c;
+        }
+        else {
+            /* read on to the newline, but don't use the line */
+            too_long = true;
+        }
+    }
+    line[len] = '\0';
+    if (eof) {
+        return -1;
+    }
+    return too_long ? -2 : (int)len;
+}
+
+/* Splits the next space separated token from *pos. */
+static char *_next_token(char **pos)
+{
+    char *start = *pos;
+    while (*start == ' ') {
+        start++;
+    }
+    if (*start == '\0') {
+        return NULL;
+    }
+    char *end = strchr(start, ' ');
+    if (end) {
+        *end = '\0';
+        *pos = end + 1;
+    }
+    else {
+        *pos = start + strlen(start);
+    }
+    return start;
+}
+
+/*
+ * Response callback. Runs in the gcoap thread.
+ */
+static void _batch_resp_handler(unsigned req_state, coap_pkt_t* pdu,
+                                sock_udp_ep_t *remote)
+{
+    (void)remote;
+    uint32_t now = xtimer_now_usec();
+
+    gcoap_cli_count_resp(req_state);
+    mutex_lock(&_batch.track.lock);
+    reqtrack_slot_t *slot = reqtrack_find(&_batch.track, pdu);
+    if (!slot) {
+        DEBUG("batch: unexpected response\n");
+        mutex_unlock(&_batch.track.lock);
+        return;
+    }
+
+    _batch_req_t *req = slot->ctx;
+    req->latency_us = now - slot->sent_us;
+    if (req_state == GCOAP_MEMO_TIMEOUT) {
+        req->state = BATCH_TIMEOUT;
+    }
+    else if (req_state == GCOAP_MEMO_ERR) {
+        req->state = BATCH_ERR;
+    }
+    else {
+        req->state = BATCH_DONE;
+        req->code = coap_get_code_raw(pdu);
+    }
+    reqtrack_done(&_batch.track, slot);
+}
+
+/*
+ * Parses a request line, and sends the request. Returns 0 if sent, 1 if the
+ * line is empty or a comment, or -1 on error.
+ */
+static int _send_line(char *line)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote;
+    unsigned msg_type = COAP_TYPE_NON;
+    unsigned method = 0;
+    char *pos = line;
+
+    char *method_str = _next_token(&pos);
+    if (!method_str || method_str[0] == '#') {
+        return 1;
+    }
+    for (unsigned i = 0; i < sizeof(_method_names) / sizeof(_method_names[0]); i++) {
+        if (strcmp(method_str, _method_names[i]) == 0) {
+            method = i + 1;
+        }
+    }
+    char *addr_str = _next_token(&pos);
+    if (addr_str && strcmp(addr_str, "-c") == 0) {
+        msg_type = COAP_TYPE_CON;
+        addr_str = _next_token(&pos);
+    }
+    char *port_str = _next_token(&pos);
+    char *path = _next_token(&pos);
+    /* remainder of line is the payload */
+    char *payload = pos;
+
+    if (!method || !path || strlen(path) >= BATCH_PATH_MAX
+            || (method == COAP_METHOD_GET && *payload)) {
+        printf("batch: can't parse line %u\n", _batch.count + 1);
+        return -1;
+    }
+    if (!gcoap_cli_init_remote(&remote, addr_str, port_str)) {
+        return -1;
+    }
+
+    gcoap_req_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, method, path);
+    coap_hdr_set_type(pdu.hdr, msg_type);
+    size_t paylen = strlen(payload);
+    size_t len;
+    if (paylen) {
+        coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
+        if (pdu.payload_len < paylen) {
+            printf("batch: payload too large on line %u\n", _batch.count + 1);
+            return -1;
+        }
+        memcpy(pdu.payload, payload, paylen);
+        len += paylen;
+    }
+    else {
+        len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+    }
+
+    _batch_req_t *req = &_batch.reqs[_batch.count++];
+    memset(req, 0, sizeof(*req));
+    req->state = BATCH_PENDING;
+    req->method = method;
+    strcpy(req->path, path);
+
+    /* window is at most BATCH_WINDOW_MAX, so a slot is free */
+    reqtrack_slot_t *slot = reqtrack_add(&_batch.track, &pdu, req);
+    if (!slot || !gcoap_cli_send(&buf[0], len, &remote, _batch_resp_handler)) {
+        if (slot) {
+            reqtrack_remove(&_batch.track, slot);
+        }
+        req->state = BATCH_SEND_FAILED;
+    }
+    return 0;
+}
+
+static void _print_summary(uint32_t elapsed)
+{
+    unsigned ok = 0;
+
+    puts("  # method path                     status   ms");
+    for (unsigned i = 0; i < _batch.count; i++) {
+        _batch_req_t *req = &_batch.reqs[i];
+
+        printf("%3u %-6s %-24s ", i + 1, _method_names[req->method - 1],
+               req->path);
+        switch (req->state) {
+        case BATCH_DONE:
+            printf("  %1u.%02u", req->code >> 5, req->code & 0x1F);
+            if ((req->code >> 5) == COAP_CLASS_SUCCESS) {
+                ok++;
+            }
+            break;
+        case BATCH_TIMEOUT:
+            printf("timeout");
+            break;
+        case BATCH_SEND_FAILED:
+            printf("sendfail");
+            break;
+        default:
+            printf("  error");
+            break;
+        }
+        printf(" %4lu\n", (unsigned long)(req->latency_us / US_PER_MS));
+    }
+    printf("batch: %u requests, %u success, %lu ms elapsed\n", _batch.count, ok,
+           (unsigned long)(elapsed / US_PER_MS));
+}
+
+int gcoap_cli_batch_cmd(int argc, char **argv)
+{
+    char line[BATCH_LINE_MAX];
+    unsigned window = BATCH_WINDOW_MAX;
+    int apos = 2;
+    int res;
+
+    if (argc > apos + 1 && strcmp(argv[apos], "-w") == 0) {
+        window = strtoul(argv[apos+1], NULL, 10);
+        apos += 2;
+    }
+    if (argc != apos + 1 || window == 0) {
+        printf("usage: %s batch [-w window] <file>\n", argv[0]);
+        printf("Options\n");
+        printf("    -w window  Max outstanding requests; default and max %u\n",
+               BATCH_WINDOW_MAX);
+        return 1;
+    }
+    if (window > BATCH_WINDOW_MAX) {
+        printf("batch: window limited to GCOAP_REQ_WAITING_MAX (%u)\n",
+               BATCH_WINDOW_MAX);
+        window = BATCH_WINDOW_MAX;
+    }
+
+    memset(&_reader, 0, sizeof(_reader));
+    _reader.fd = vfs_open(argv[apos], O_RDONLY, 0);
+    if (_reader.fd < 0) {
+        printf("batch: unable to open %s\n", argv[apos]);
+        return 1;
+    }
+
+    reqtrack_reset(&_batch.track);
+    _batch.count = 0;
+
+    bool eof = false;
+    uint32_t start = xtimer_now_usec();
+    while (!eof || reqtrack_outstanding(&_batch.track)) {
+        if (!eof && reqtrack_outstanding(&_batch.track) < window) {
+            if (_batch.count == GCOAP_CLI_BATCH_MAX) {
+                printf("batch: stopping at %u requests\n", GCOAP_CLI_BATCH_MAX);
+                eof = true;
+            }
+            else if ((res = _read_line(line, sizeof(line))) < 0) {
+                if (res == -2) {
+                    printf("batch: line %u too long\n", _batch.count + 1);
+                }
+                eof = true;
+            }
+            else if (_send_line(line) < 0) {
+                /* stop on a bad line, but collect responses already sent */
+                eof = true;
+            }
+            continue;
+        }
+
+        reqtrack_wait(US_PER_SEC);
+    }
+    uint32_t elapsed = xtimer_now_usec() - start;
+
+    vfs_close(_reader.fd);
+
+    _print_summary(elapsed);
+    return 0;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* MODULE_VFS */
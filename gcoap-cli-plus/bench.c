@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI load generator, with round trip time histogram
+ *
+ * Keeps up to 'window' GET requests outstanding and sends at a target rate.
+ * The response callback runs in the gcoap thread. It records the round trip
+ * time, and the request tracker then wakes the CLI thread to send the next
+ * request.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bitarithm.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+#include "reqtrack.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Outstanding requests are limited by gcoap's memo table */
+#define BENCH_WINDOW_MAX        (REQTRACK_SLOTS_MAX)
+
+/*
+ * Histogram buckets. Each power of two is split into 2^BENCH_HIST_SUBBITS
+ * buckets, so a bucket's width is at most 25% of its lower bound. 124 buckets
+ * cover the full range of a 32-bit microsecond value.
+ */
+#define BENCH_HIST_SUBBITS      (2U)
+#define BENCH_HIST_BUCKETS      (124U)
+
+/* Benchmark state, shared between CLI and gcoap threads; track.lock guards */
+static struct {
+    reqtrack_t track;
+    uint32_t hist[BENCH_HIST_BUCKETS];
+    uint32_t rtt_max;
+    unsigned responses;
+    unsigned errors;
+    unsigned timeouts;
+} _bench = { .track = { .lock = MUTEX_INIT } };
+
+static unsigned _hist_bucket(uint32_t us)
+{
+    if (us < (1U << BENCH_HIST_SUBBITS)) {
+        return us;
+    }
+    unsigned msb = bitarithm_msb(us);
+    unsigned sub = (us >> (msb - BENCH_HIST_SUBBITS))
+                        & ((1U << BENCH_HIST_SUBBITS) - 1);
+    return ((msb - BENCH_HIST_SUBBITS + 1) << BENCH_HIST_SUBBITS) + sub;
+}
+
+/* Returns the upper bound value for a bucket. */
+static uint32_t _hist_value(unsigned bucket)
+{
+    if (bucket < (1U << BENCH_HIST_SUBBITS)) {
+        return bucket;
+    }
+    unsigned msb = (bucket >> BENCH_HIST_SUBBITS) + BENCH_HIST_SUBBITS - 1;
+    unsigned sub = bucket & ((1U << BENCH_HIST_SUBBITS) - 1);
+    unsigned shift = msb - BENCH_HIST_SUBBITS;
+    uint32_t low = ((1U << BENCH_HIST_SUBBITS) + sub) << shift;
+    return low + ((1U << shift) - 1);
+}
+
+/* Returns the RTT at or below which 'pct' percent of responses fall. */
+static uint32_t _hist_percentile(unsigned pct)
+{
+    uint32_t target = ((uint64_t)_bench.responses * pct + 99) / 100;
+    uint32_t seen = 0;
+
+    for (unsigned i = 0; i < BENCH_HIST_BUCKETS; i++) {
+        seen += _bench.hist[i];
+        if (seen >= target && seen > 0) {
+            uint32_t value = _hist_value(i);
+            return (value < _bench.rtt_max) ? value : _bench.rtt_max;
+        }
+    }
+    return _bench.rtt_max;
+}
+
+/*
+ * Response callback. Runs in the gcoap thread.
+ */
+static void _bench_resp_handler(unsigned req_state, coap_pkt_t* pdu,
+                                sock_udp_ep_t *remote)
+{
+    (void)remote;
+    uint32_t now = xtimer_now_usec();
+
+    gcoap_cli_count_resp(req_state);
+    mutex_lock(&_bench.track.lock);
+    reqtrack_slot_t *slot = reqtrack_find(&_bench.track, pdu);
+    if (!slot) {
+        DEBUG("bench: unexpected response\n");
+        mutex_unlock(&_bench.track.lock);
+        return;
+    }
+
+    if (req_state == GCOAP_MEMO_TIMEOUT) {
+        _bench.timeouts++;
+    }
+    else if (req_state == GCOAP_MEMO_ERR
+                || coap_get_code_class(pdu) != COAP_CLASS_SUCCESS) {
+        _bench.errors++;
+    }
+    else {
+        uint32_t rtt = now - slot->sent_us;
+        _bench.hist[_hist_bucket(rtt)]++;
+        if (rtt > _bench.rtt_max) {
+            _bench.rtt_max = rtt;
+        }
+        _bench.responses++;
+    }
+    reqtrack_done(&_bench.track, slot);
+}
+
+/* Builds and sends the next request. Returns 1 on success, 0 on failure. */
+static int _send_next(sock_udp_ep_t *remote, char *path, unsigned msg_type)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+
+    gcoap_req_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, COAP_METHOD_GET, path);
+    coap_hdr_set_type(pdu.hdr, msg_type);
+    size_t len = coap_opt_finish(&pdu, COAP_OPT_FINISH_NONE);
+
+    /* window is at most BENCH_WINDOW_MAX, so a slot is free */
+    reqtrack_slot_t *slot = reqtrack_add(&_bench.track, &pdu, NULL);
+    assert(slot);
+
+    size_t bytes_sent = gcoap_cli_send(&buf[0], len, remote, _bench_resp_handler);
+    if (!bytes_sent) {
+        reqtrack_remove(&_bench.track, slot);
+    }
+
+    return bytes_sent ? 1 : 0;
+}
+
+static void _print_rtt(const char *label, uint32_t us)
+{
+    printf("%8s: %lu.%03lu ms\n", label, (unsigned long)(us / 1000),
+                                         (unsigned long)(us % 1000));
+}
+
+int gcoap_cli_bench_cmd(int argc, char **argv)
+{
+    sock_udp_ep_t remote;
+    unsigned count = 100;
+    unsigned rate = 0;
+    unsigned window = 1;
+    unsigned msg_type = COAP_TYPE_NON;
+    unsigned send_errors = 0;
+    int apos = 2;
+
+    if (argc > apos && strcmp(argv[apos], "-c") == 0) {
+        msg_type = COAP_TYPE_CON;
+        apos++;
+    }
+    if (argc < apos + 3) {
+        goto usage;
+    }
+    char *path = argv[apos+2];
+
+    for (int i = apos + 3; i < argc; i += 2) {
+        if (i + 1 >= argc) {
+            goto usage;
+        }
+        unsigned value = strtoul(argv[i+1], NULL, 10);
+        if (strcmp(argv[i], "-n") == 0 && value) {
+            count = value;
+        }
+        else if (strcmp(argv[i], "-r") == 0) {
+            rate = value;
+        }
+        else if (strcmp(argv[i], "-w") == 0 && value) {
+            window = value;
+        }
+        else {
+            goto usage;
+        }
+    }
+    if (window > BENCH_WINDOW_MAX) {
+        printf("bench: window limited to GCOAP_REQ_WAITING_MAX (%u)\n",
+               BENCH_WINDOW_MAX);
+        window = BENCH_WINDOW_MAX;
+    }
+
+    if (!gcoap_cli_init_remote(&remote, argv[apos], argv[apos+1])) {
+        return 1;
+    }
+
+    reqtrack_reset(&_bench.track);
+    mutex_lock(&_bench.track.lock);
+    memset(_bench.hist, 0, sizeof(_bench.hist));
+    _bench.rtt_max = 0;
+    _bench.responses = 0;
+    _bench.errors = 0;
+    _bench.timeouts = 0;
+    mutex_unlock(&_bench.track.lock);
+
+    printf("bench: %u requests to %s, window %u, rate ", count, path, window);
+    if (rate) {
+        printf("%u/s\n", rate);
+    }
+    else {
+        puts("unlimited");
+    }
+
+    uint32_t interval = rate ? (US_PER_SEC / rate) : 0;
+    uint32_t start = xtimer_now_usec();
+    uint32_t next_send = start;
+    unsigned sent = 0;
+
+    while (sent < count || reqtrack_outstanding(&_bench.track)) {
+        uint32_t now = xtimer_now_usec();
+        uint32_t timeout = US_PER_SEC;
+
+        if (sent < count && reqtrack_outstanding(&_bench.track) < window) {
+            int32_t wait = (int32_t)(next_send - now);
+            if (wait <= 0) {
+                /* a failed send counts toward 'count', so a persistent
+                 * failure, like no route, can't stall the benchmark */
+                if (!_send_next(&remote, path, msg_type)) {
+                    send_errors++;
+                }
+                sent++;
+                next_send += interval;
+                /* don't accumulate a burst if we fell behind the rate */
+                if ((int32_t)(now - next_send) > (int32_t)interval) {
+                    next_send = now;
+                }
+                continue;
+            }
+            timeout = wait;
+        }
+
+        reqtrack_wait(timeout);
+    }
+    uint32_t elapsed = xtimer_now_usec() - start;
+
+    uint64_t rate_x100 = elapsed
+                         ? ((uint64_t)_bench.responses * 100 * US_PER_SEC) / elapsed
+                         : 0;
+    printf("bench: sent %u, responses %u, timeouts %u, errors %u, "
+           "send failures %u\n", sent, _bench.responses, _bench.timeouts,
+           _bench.errors, send_errors);
+    printf("bench: elapsed %lu ms, achieved %lu.%02lu req/s\n",
+           (unsigned long)(elapsed / 1000), (unsigned long)(rate_x100 / 100),
+           (unsigned long)(rate_x100 % 100));
+    if (_bench.responses) {
+        _print_rtt("p50", _hist_percentile(50));
+        _print_rtt("p90", _hist_percentile(90));
+        _print_rtt("p99", _hist_percentile(99));
+        _print_rtt("max", _bench.rtt_max);
+    }
+    return 0;
+
+    usage:
+    printf("usage: %s bench [-c] <addr>[%%iface] <port> <path> [-n count] "
+           "[-r rate] [-w window]\n", argv[0]);
+    printf("Options\n");
+    printf("    -c         Send confirmably\n");
+    printf("    -n count   Number of GET requests; default 100\n");
+    printf("    -r rate    Target requests per second; default 0, unlimited\n");
+    printf("    -w window  Max outstanding requests; default 1, max %u\n",
+           BENCH_WINDOW_MAX);
+    return 1;
+}
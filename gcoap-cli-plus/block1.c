@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI blockwise POST/PUT, for payloads larger than a PDU
+ *
+ * Sends the first block from the CLI thread. The response handler then sends
+ * each following block when the server responds 2.31 Continue. The payload is
+ * read a block at a time from its source, so it need not fit in memory.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "net/gcoap.h"
+#include "shell.h"
+#include "xtimer.h"
+#ifdef MODULE_VFS
+#include "vfs.h"
+#endif
+#include "gcoap_cli.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define BLOCK1_PATH_MAX     (32U)
+
+/* State for the single upload supported */
+static struct {
+    bool active;
+    unsigned method;
+    unsigned msg_type;
+    unsigned blksize;
+    unsigned blknum;
+    char path[BLOCK1_PATH_MAX];
+    gcoap_cli_source_t source;
+    size_t total;
+    uint32_t start_us;
+    gcoap_resp_handler_t resp_handler;
+    uint8_t token[GCOAP_TOKENLEN];      /* of the block in flight */
+    unsigned token_len;
+    char text[SHELL_DEFAULT_BUFSIZE];
+#ifdef MODULE_VFS
+    int fd;
+#endif
+} _block1;
+
+/* Copies payload bytes for [offset, offset + len) from the source. */
+static int _read_source(size_t offset, uint8_t *dst, size_t len)
+{
+    switch (_block1.source) {
+    case GCOAP_CLI_SOURCE_TEXT:
+        memcpy(dst, &_block1.text[offset], len);
+        return 0;
+    case GCOAP_CLI_SOURCE_GEN:
+        /* repeating alphabet, so the server can check content */
+        for (size_t i = 0; i < len; i++) {
+            dst[i] = 'a' + (offset + i) % 26;
+        }
+        return 0;
+#ifdef MODULE_VFS
+    case GCOAP_CLI_SOURCE_FILE:
+        if (vfs_lseek(_block1.fd, offset, SEEK_SET) < 0
+                || vfs_read(_block1.fd, dst, len) != (ssize_t)len) {
+            return -1;
+        }
+        return 0;
+#endif
+    default:
+        return -1;
+    }
+}
+
+static void _finish(void)
+{
+#ifdef MODULE_VFS
+    if (_block1.source == GCOAP_CLI_SOURCE_FILE) {
+        vfs_close(_block1.fd);
+    }
+#endif
+    _block1.active = false;
+}
+
+/*
+ * Writes and sends the current block. Uses the buffer already attached to
+ * pdu. Returns 0 on success, -1 on failure.
+ */
+static int _send_block(coap_pkt_t *pdu, uint8_t *buf, sock_udp_ep_t *remote)
+{
+    coap_block_slicer_t slicer;
+    coap_block_slicer_init(&slicer, _block1.blknum, _block1.blksize);
+
+    size_t chunk = _block1.total - slicer.start;
+    bool more = chunk > _block1.blksize;
+    if (more) {
+        chunk = _block1.blksize;
+    }
+
+    gcoap_req_init(pdu, buf, GCOAP_PDU_BUF_SIZE, _block1.method, _block1.path);
+    coap_hdr_set_type(pdu->hdr, _block1.msg_type);
+    coap_opt_add_format(pdu, (_block1.source == GCOAP_CLI_SOURCE_TEXT)
+                                ? COAP_FORMAT_TEXT : COAP_FORMAT_OCTET);
+    coap_opt_add_block1(pdu, &slicer, more);
+    if (_block1.blknum == 0) {
+        /* tell the server the total size up front */
+        coap_opt_add_uint(pdu, COAP_OPT_SIZE1, _block1.total);
+    }
+    ssize_t len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+
+    if (pdu->payload_len < chunk) {
+        puts("gcoap_cli: block size too large for msg buffer");
+        return -1;
+    }
+    if (_read_source(slicer.start, pdu->payload, chunk) < 0) {
+        puts("gcoap_cli: unable to read payload source");
+        return -1;
+    }
+    len += chunk;
+
+    /* only the response to this block belongs to the upload */
+    _block1.token_len = coap_get_token_len(pdu);
+    memcpy(_block1.token, coap_hdr_data_ptr(pdu->hdr), _block1.token_len);
+
+    if (!gcoap_cli_send(buf, len, remote, _block1.resp_handler)) {
+        puts("gcoap_cli: msg send failed");
+        return -1;
+    }
+    return 0;
+}
+
+/* Returns true if pdu responds to the block in flight, or timed out for it. */
+static bool _is_current(coap_pkt_t *pdu)
+{
+    return coap_get_token_len(pdu) == _block1.token_len
+            && memcmp(coap_hdr_data_ptr(pdu->hdr), _block1.token,
+                      _block1.token_len) == 0;
+}
+
+int gcoap_cli_block1_start(unsigned method, unsigned msg_type, unsigned blksize,
+                           char *addr_str, char *port_str, const char *path,
+                           gcoap_cli_source_t source, const char *src_arg,
+                           gcoap_resp_handler_t resp_handler)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    sock_udp_ep_t remote;
+
+    if (_block1.active) {
+        puts("gcoap_cli: blockwise upload already in progress");
+        return -1;
+    }
+    if (strlen(path) >= BLOCK1_PATH_MAX) {
+        puts("gcoap_cli: path too long");
+        return -1;
+    }
+    if (!gcoap_cli_init_remote(&remote, addr_str, port_str)) {
+        return -1;
+    }
+
+    switch (source) {
+    case GCOAP_CLI_SOURCE_TEXT:
+        _block1.total = strlen(src_arg);
+        if (_block1.total >= sizeof(_block1.text)) {
+            printf("gcoap_cli: payload longer than %u bytes\n",
+                   (unsigned)sizeof(_block1.text) - 1);
+            return -1;
+        }
+        /* shell line buffer is reused, so keep a copy */
+        memcpy(_block1.text, src_arg, _block1.total);
+        break;
+    case GCOAP_CLI_SOURCE_GEN:
+        _block1.total = strtoul(src_arg, NULL, 10);
+        if (!_block1.total) {
+            puts("gcoap_cli: generated size must be non-zero");
+            return -1;
+        }
+        break;
+#ifdef MODULE_VFS
+    case GCOAP_CLI_SOURCE_FILE: {
+        _block1.fd = vfs_open(src_arg, O_RDONLY, 0);
+        if (_block1.fd < 0) {
+            printf("gcoap_cli: unable to open %s\n", src_arg);
+            return -1;
+        }
+        off_t size = vfs_lseek(_block1.fd, 0, SEEK_END);
+        if (size <= 0) {
+            puts("gcoap_cli: file empty or unreadable");
+            vfs_close(_block1.fd);
+            return -1;
+        }
+        _block1.total = size;
+        break;
+    }
+#endif
+    default:
+        puts("gcoap_cli: payload source not supported");
+        return -1;
+    }
+
+    _block1.method = method;
+    _block1.msg_type = msg_type;
+    _block1.blksize = blksize;
+    _block1.blknum = 0;
+    _block1.source = source;
+    _block1.resp_handler = resp_handler;
+    strcpy(_block1.path, path);
+    _block1.active = true;
+
+    printf("gcoap_cli: sending %u bytes in blocks of %u\n",
+           (unsigned)_block1.total, blksize);
+    _block1.start_us = xtimer_now_usec();
+    if (_send_block(&pdu, buf, &remote) < 0) {
+        _finish();
+        return -1;
+    }
+    return 0;
+}
+
+int gcoap_cli_block1_resp(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote)
+{
+    if (!_block1.active || !_is_current(pdu)) {
+        return 0;
+    }
+    if (req_state != GCOAP_MEMO_RESP) {
+        puts("--- blockwise upload failed ---");
+        _finish();
+        return 0;
+    }
+
+    if (coap_get_code_raw(pdu) == COAP_CODE_CONTINUE) {
+        coap_block1_t block;
+        unsigned next_offset = (_block1.blknum + 1) * _block1.blksize;
+
+        /* server may ask for a smaller block size */
+        if (coap_get_block1(pdu, &block) && block.szx < coap_size2szx(_block1.blksize)) {
+            _block1.blksize = coap_szx2size(block.szx);
+            DEBUG("gcoap_cli: server reduced block size to %u\n", _block1.blksize);
+        }
+        _block1.blknum = next_offset / _block1.blksize;
+
+        if (next_offset >= _block1.total
+                || _send_block(pdu, (uint8_t *)pdu->hdr, remote) < 0) {
+            puts("--- blockwise upload failed ---");
+            _finish();
+            return 0;
+        }
+        return 1;
+    }
+
+    if (coap_get_code_class(pdu) == COAP_CLASS_SUCCESS) {
+        uint32_t elapsed = xtimer_now_usec() - _block1.start_us;
+        uint64_t goodput = elapsed
+                           ? ((uint64_t)_block1.total * US_PER_SEC) / elapsed : 0;
+        printf("--- blockwise upload complete: %u bytes in %lu ms, %lu B/s ---\n",
+               (unsigned)_block1.total, (unsigned long)(elapsed / US_PER_MS),
+               (unsigned long)goodput);
+    }
+    else {
+        puts("--- blockwise upload failed ---");
+    }
+    _finish();
+    return 0;
+}
@@ -18,13 +18,20 @@
  * @}
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "msg.h"
+#include "mutex.h"
 #include "net/gcoap.h"
 #include "od.h"
 #include "fmt.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+#include "senml.h"
 
 #define ENABLE_DEBUG (0)
 #include "debug.h"
@@ -33,6 +40,7 @@ static void _resp_handler(unsigned req_state, coap_pkt_t* pdu,
                           sock_udp_ep_t *remote);
 static ssize_t _stats_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
 static ssize_t _riot_board_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx);
+static void _stats_changed(void);
 
 /* CoAP resources. Must be sorted by path (ASCII order). */
 static const coap_resource_t _resources[] = {
@@ -46,12 +54,73 @@ static gcoap_listener_t _listener = {
     NULL
 };
 
+/* Observable /cli/stats resource */
+static const coap_resource_t *_stats_resource = &_resources[0];
+
 /* retain request path to re-request if response includes block */
 #define _LAST_REQ_PATH_MAX (32)
 static char _last_req_path[_LAST_REQ_PATH_MAX];
 
 /* Counts requests sent by CLI. */
-static uint16_t req_count = 0;
+static uint32_t req_count = 0;
+/* Counts responses to, timeouts for, and bytes sent in CLI requests. */
+static uint32_t resp_count = 0;
+static uint32_t timeout_count = 0;
+static uint32_t req_bytes = 0;
+
+#ifndef COAP_OPT_ACCEPT
+#define COAP_OPT_ACCEPT         (17)
+#endif
+
+/* /cli/stats counter records; also the SenML record count */
+#define STATS_RECORDS           (5U)
+#define STATS_BASE_NAME         "cli:"
+/* Max /cli/stats payload; a JSON pack with five 10 digit values is 156 bytes */
+#define STATS_PAYLOAD_MAX       (160U)
+/* Block2 size for a notification; a response uses the request's block size */
+#define STATS_BLOCK_SIZE        (64U)
+/* Iterations to time encodings for 'coap info senml' */
+#define STATS_ENCODE_REPS       (1000U)
+
+/*
+ * /cli/stats notification coalescing. A change within pmin seconds of the last
+ * notification is deferred until pmin expires, and merged with any further
+ * changes. A CON notification is sent if there is no notification for pmax
+ * seconds.
+ */
+#ifndef GCOAP_CLI_NOTIFY_PMIN
+#define GCOAP_CLI_NOTIFY_PMIN   (1U)
+#endif
+#ifndef GCOAP_CLI_NOTIFY_PMAX
+#define GCOAP_CLI_NOTIFY_PMAX   (60U)
+#endif
+#if (GCOAP_CLI_NOTIFY_PMAX == 0) || (GCOAP_CLI_NOTIFY_PMIN > GCOAP_CLI_NOTIFY_PMAX)
+#error "GCOAP_CLI_NOTIFY_PMAX must be non-zero, and not less than GCOAP_CLI_NOTIFY_PMIN"
+#endif
+
+#define NOTIFY_MSG_TYPE_CHANGED (0x3310)
+#define NOTIFY_QUEUE_SIZE       (4U)
+
+static struct {
+    mutex_t lock;               /* for pmin, pmax, suppressed and format */
+    kernel_pid_t pid;
+    unsigned format;            /* from the observer's Accept option */
+    uint32_t pmin;              /* sec */
+    uint32_t pmax;              /* sec */
+    uint64_t last_us;           /* time of last notification */
+    bool pending;               /* change not yet notified */
+    unsigned sent;
+    unsigned con_sent;          /* forced by pmax; also counted in 'sent' */
+    unsigned suppressed;        /* changes merged into a pending notification */
+} _notify = {
+    .lock = MUTEX_INIT,
+    .pid = KERNEL_PID_UNDEF,
+    .format = SENML_FORMAT_CBOR,
+    .pmin = GCOAP_CLI_NOTIFY_PMIN,
+    .pmax = GCOAP_CLI_NOTIFY_PMAX,
+};
+
+static char _notify_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
 
 /*
  * Response callback.
@@ -59,14 +128,21 @@ static uint16_t req_count = 0;
 static void _resp_handler(unsigned req_state, coap_pkt_t* pdu,
                           sock_udp_ep_t *remote)
 {
-    (void)remote;       /* not interested in the source currently */
+    gcoap_cli_count_resp(req_state);
 
     if (req_state == GCOAP_MEMO_TIMEOUT) {
         printf("gcoap: timeout for msg ID %02u\n", coap_get_id(pdu));
+        gcoap_cli_block1_resp(req_state, pdu, remote);
         return;
     }
     else if (req_state == GCOAP_MEMO_ERR) {
         printf("gcoap: error in response\n");
+        gcoap_cli_block1_resp(req_state, pdu, remote);
+        return;
+    }
+
+    if (gcoap_cli_block1_resp(req_state, pdu, remote)) {
+        /* sent next block for upload */
         return;
     }
 
@@ -120,13 +196,92 @@ static void _resp_handler(unsigned req_state, coap_pkt_t* pdu,
     }
 }
 
+/* Fills in the /cli/stats counter records. */
+static void _stats_records(senml_record_t *records)
+{
+    records[0].name = "req";
+    records[0].value = req_count;
+    records[1].name = "resp";
+    records[1].value = resp_count;
+    records[2].name = "timeout";
+    records[2].value = timeout_count;
+    records[3].name = "bytes";
+    records[3].value = req_bytes;
+    records[4].name = "open";
+    records[4].value = gcoap_op_state();
+}
+
+/* Writes records as text, one 'name value' line each. Returns length or -1. */
+static ssize_t _stats_text(uint8_t *buf, size_t len,
+                           const senml_record_t *records, unsigned count)
+{
+    size_t pos = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        size_t name_len = strlen(records[i].name);
+        /* name, space, max 10 digits, newline */
+        if (len - pos < name_len + 12) {
+            return -1;
+        }
+        memcpy(&buf[pos], records[i].name, name_len);
+        pos += name_len;
+        buf[pos++] = ' ';
+        pos += fmt_u32_dec((char *)&buf[pos], records[i].value);
+        buf[pos++] = '\n';
+    }
+    return pos;
+}
+
+/*
+ * Writes the /cli/stats content format and the block of the payload for
+ * slicer to a PDU, which must be initialized. A JSON pack may be larger than a
+ * PDU, so the payload always is sent blockwise. Returns the PDU length, or -1
+ * if the payload can't be encoded.
+ */
+static ssize_t _stats_write(coap_pkt_t *pdu, unsigned format,
+                            coap_block_slicer_t *slicer)
+{
+    senml_record_t records[STATS_RECORDS];
+    uint8_t payload[STATS_PAYLOAD_MAX];
+    ssize_t payload_len;
+
+    _stats_records(records);
+    switch (format) {
+    case SENML_FORMAT_CBOR:
+        payload_len = senml_encode_cbor(payload, sizeof(payload),
+                                        STATS_BASE_NAME, records, STATS_RECORDS);
+        break;
+    case SENML_FORMAT_JSON:
+        payload_len = senml_encode_json(payload, sizeof(payload),
+                                        STATS_BASE_NAME, records, STATS_RECORDS);
+        break;
+    default:
+        payload_len = _stats_text(payload, sizeof(payload), records,
+                                  STATS_RECORDS);
+        break;
+    }
+    if (payload_len < 0) {
+        return -1;
+    }
+
+    coap_opt_add_format(pdu, format);
+    coap_opt_add_block2(pdu, slicer, 1);
+    ssize_t len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+    len += coap_blockwise_put_bytes(slicer, pdu->payload, payload, payload_len);
+    coap_block2_finish(slicer);
+    return len;
+}
+
 /*
  * Server callback for /cli/stats. Accepts either a GET or a PUT.
  *
- * GET: Returns the count of packets sent by the CLI.
- * PUT: Updates the count of packets. Rejects an obviously bad request, but
- *      allows any two byte value for example purposes. Semantically, the only
- *      valid action is to set the value to 0.
+ * GET: Returns the CLI request counters, as SenML CBOR by default. The Accept
+ *      option may select SenML JSON or text/plain instead, also for Observe
+ *      notifications.
+ * PUT: Updates the count of requests sent. Rejects an obviously bad request,
+ *      but allows any 32-bit value for example purposes. Semantically, the
+ *      only valid action is to set the value to 0, which also resets the
+ *      other counters.
  */
 static ssize_t _stats_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *ctx)
 {
@@ -136,22 +291,48 @@ static ssize_t _stats_handler(coap_pkt_t* pdu, uint8_t *buf, size_t len, void *c
     unsigned method_flag = coap_method2flag(coap_get_code_detail(pdu));
 
     switch(method_flag) {
-        case COAP_GET:
-            gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
-            coap_opt_add_format(pdu, COAP_FORMAT_TEXT);
-            size_t resp_len = coap_opt_finish(pdu, COAP_OPT_FINISH_PAYLOAD);
+        case COAP_GET: {
+            uint32_t accept;
+            if (coap_opt_get_uint(pdu, COAP_OPT_ACCEPT, &accept) < 0) {
+                accept = SENML_FORMAT_CBOR;
+            }
+            if (accept != SENML_FORMAT_CBOR && accept != SENML_FORMAT_JSON
+                    && accept != COAP_FORMAT_TEXT) {
+                return gcoap_response(pdu, buf, len, COAP_CODE_NOT_ACCEPTABLE);
+            }
+
+            if (coap_has_observe(pdu)) {
+                /* gcoap registered the observer; it does not keep Accept */
+                mutex_lock(&_notify.lock);
+                _notify.format = accept;
+                mutex_unlock(&_notify.lock);
+            }
 
-            /* write the response buffer with the request count value */
-            resp_len += fmt_u16_dec((char *)pdu->payload, req_count);
+            coap_block_slicer_t slicer;
+            coap_block2_init(pdu, &slicer);
+            gcoap_resp_init(pdu, buf, len, COAP_CODE_CONTENT);
+            ssize_t resp_len = _stats_write(pdu, accept, &slicer);
+            if (resp_len < 0) {
+                puts("gcoap_cli: msg buffer too small");
+                return gcoap_response(pdu, buf, len,
+                                      COAP_CODE_INTERNAL_SERVER_ERROR);
+            }
             return resp_len;
+        }
 
         case COAP_PUT:
             /* convert the payload to an integer and update the internal
                value */
-            if (pdu->payload_len <= 5) {
-                char payload[6] = { 0 };
+            if (pdu->payload_len <= 10) {
+                char payload[11] = { 0 };
                 memcpy(payload, (char *)pdu->payload, pdu->payload_len);
-                req_count = (uint16_t)strtoul(payload, NULL, 10);
+                req_count = strtoul(payload, NULL, 10);
+                if (req_count == 0) {
+                    resp_count = 0;
+                    timeout_count = 0;
+                    req_bytes = 0;
+                }
+                _stats_changed();
                 return gcoap_response(pdu, buf, len, COAP_CODE_CHANGED);
             }
             else {
@@ -180,23 +361,155 @@ static ssize_t _riot_board_handler(coap_pkt_t *pdu, uint8_t *buf, size_t len, vo
     }
 }
 
-static size_t _send(uint8_t *buf, size_t len, char *addr_str, char *port_str)
+/*
+ * Sends a /cli/stats notification, if there is an observer.
+ */
+static void _notify_send(unsigned msg_type)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    coap_pkt_t pdu;
+    coap_block_slicer_t slicer;
+    ssize_t len;
+
+    switch (gcoap_obs_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, _stats_resource)) {
+    case GCOAP_OBS_INIT_OK:
+        DEBUG("gcoap_cli: creating /cli/stats notification\n");
+        coap_hdr_set_type(pdu.hdr, msg_type);
+        /* first block only; the observer may GET the rest */
+        coap_block_slicer_init(&slicer, 0, STATS_BLOCK_SIZE);
+        mutex_lock(&_notify.lock);
+        unsigned format = _notify.format;
+        mutex_unlock(&_notify.lock);
+        len = _stats_write(&pdu, format, &slicer);
+        if (len > 0 && gcoap_obs_send(&buf[0], len, _stats_resource) > 0) {
+            _notify.sent++;
+            if (msg_type == COAP_TYPE_CON) {
+                _notify.con_sent++;
+            }
+        }
+        break;
+    case GCOAP_OBS_INIT_UNUSED:
+        DEBUG("gcoap_cli: no observer for /cli/stats\n");
+        break;
+    case GCOAP_OBS_INIT_ERR:
+        DEBUG("gcoap_cli: error initializing /cli/stats notification\n");
+        break;
+    }
+    _notify.last_us = xtimer_now_usec64();
+    _notify.pending = false;
+}
+
+static void _notify_suppressed(void)
+{
+    mutex_lock(&_notify.lock);
+    _notify.suppressed++;
+    mutex_unlock(&_notify.lock);
+}
+
+/*
+ * Notifier thread for /cli/stats. Receives a message for each change in value,
+ * and otherwise wakes up when pmin or pmax expires.
+ */
+static void *_notify_thread(void *arg)
+{
+    (void)arg;
+    msg_t msg_queue[NOTIFY_QUEUE_SIZE];
+    msg_init_queue(msg_queue, NOTIFY_QUEUE_SIZE);
+
+    _notify.last_us = xtimer_now_usec64();
+    while (1) {
+        msg_t msg;
+        mutex_lock(&_notify.lock);
+        uint64_t pmin = (uint64_t)_notify.pmin * US_PER_SEC;
+        uint64_t pmax = (uint64_t)_notify.pmax * US_PER_SEC;
+        mutex_unlock(&_notify.lock);
+
+        uint64_t elapsed = xtimer_now_usec64() - _notify.last_us;
+        uint64_t limit = _notify.pending ? pmin : pmax;
+        if (elapsed >= limit) {
+            /* pmin expired with a pending change, or pmax expired */
+            _notify_send(_notify.pending ? COAP_TYPE_NON : COAP_TYPE_CON);
+            continue;
+        }
+        /* a pmax over 71 minutes exceeds a 32-bit timeout; just wait again */
+        uint64_t timeout = limit - elapsed;
+        if (xtimer_msg_receive_timeout(&msg, (timeout > UINT32_MAX)
+                                             ? UINT32_MAX : (uint32_t)timeout) < 0
+                || msg.type != NOTIFY_MSG_TYPE_CHANGED) {
+            continue;
+        }
+
+        if (_notify.pending) {
+            _notify_suppressed();
+        }
+        else if ((xtimer_now_usec64() - _notify.last_us) >= pmin) {
+            _notify_send(COAP_TYPE_NON);
+        }
+        else {
+            _notify.pending = true;
+        }
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+/*
+ * Signals a change in the /cli/stats value to the notifier thread.
+ */
+static void _stats_changed(void)
+{
+    msg_t msg = { .type = NOTIFY_MSG_TYPE_CHANGED };
+
+    /* if the queue is full, a change is pending anyway */
+    if (msg_try_send(&msg, _notify.pid) < 1) {
+        _notify_suppressed();
+    }
+}
+
+static int _notify_cmd(int argc, char **argv)
+{
+    if (argc == 4) {
+        unsigned pmin = strtoul(argv[2], NULL, 10);
+        unsigned pmax = strtoul(argv[3], NULL, 10);
+        if (pmax == 0 || pmin > pmax) {
+            puts("gcoap_cli: pmax must be non-zero, and not less than pmin");
+            return 1;
+        }
+        mutex_lock(&_notify.lock);
+        _notify.pmin = pmin;
+        _notify.pmax = pmax;
+        mutex_unlock(&_notify.lock);
+    }
+    else if (argc != 2) {
+        printf("usage: %s notify [<pmin> <pmax>]\n", argv[0]);
+        return 1;
+    }
+
+    mutex_lock(&_notify.lock);
+    printf("/cli/stats notify: pmin %lu s, pmax %lu s\n",
+           (unsigned long)_notify.pmin, (unsigned long)_notify.pmax);
+    printf("  notifications sent: %u (CON %u)\n", _notify.sent, _notify.con_sent);
+    printf("  changes suppressed: %u\n", _notify.suppressed);
+    mutex_unlock(&_notify.lock);
+    return 0;
+}
+
+int gcoap_cli_init_remote(sock_udp_ep_t *remote, char *addr_str, char *port_str)
 {
     ipv6_addr_t addr;
-    size_t bytes_sent;
-    sock_udp_ep_t remote;
 
-    remote.family = AF_INET6;
+    remote->family = AF_INET6;
 
     /* parse for interface */
     int iface = ipv6_addr_split_iface(addr_str);
     if (iface == -1) {
         if (gnrc_netif_numof() == 1) {
             /* assign the single interface found in gnrc_netif_numof() */
-            remote.netif = (uint16_t)gnrc_netif_iter(NULL)->pid;
+            remote->netif = (uint16_t)gnrc_netif_iter(NULL)->pid;
         }
         else {
-            remote.netif = SOCK_ADDR_ANY_NETIF;
+            remote->netif = SOCK_ADDR_ANY_NETIF;
         }
     }
     else {
@@ -204,7 +517,7 @@ static size_t _send(uint8_t *buf, size_t len, char *addr_str, char *port_str)
             puts("gcoap_cli: interface not valid");
             return 0;
         }
-        remote.netif = iface;
+        remote->netif = iface;
     }
 
     /* parse destination address */
@@ -212,26 +525,91 @@ static size_t _send(uint8_t *buf, size_t len, char *addr_str, char *port_str)
         puts("gcoap_cli: unable to parse destination address");
         return 0;
     }
-    if ((remote.netif == SOCK_ADDR_ANY_NETIF) && ipv6_addr_is_link_local(&addr)) {
+    if ((remote->netif == SOCK_ADDR_ANY_NETIF) && ipv6_addr_is_link_local(&addr)) {
         puts("gcoap_cli: must specify interface for link local target");
         return 0;
     }
-    memcpy(&remote.addr.ipv6[0], &addr.u8[0], sizeof(addr.u8));
+    memcpy(&remote->addr.ipv6[0], &addr.u8[0], sizeof(addr.u8));
 
     /* parse port */
-    remote.port = atoi(port_str);
-    if (remote.port == 0) {
+    remote->port = atoi(port_str);
+    if (remote->port == 0) {
         puts("gcoap_cli: unable to parse destination port");
         return 0;
     }
 
-    bytes_sent = gcoap_req_send2(buf, len, &remote, _resp_handler);
+    return 1;
+}
+
+size_t gcoap_cli_send(const uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                      gcoap_resp_handler_t resp_handler)
+{
+    size_t bytes_sent = gcoap_req_send2(buf, len, remote, resp_handler);
     if (bytes_sent > 0) {
-        req_count++;
+        gcoap_cli_count_req(bytes_sent);
     }
     return bytes_sent;
 }
 
+void gcoap_cli_count_req(size_t bytes)
+{
+    req_count++;
+    req_bytes += bytes;
+    _stats_changed();
+}
+
+void gcoap_cli_count_resp(unsigned req_state)
+{
+    if (req_state == GCOAP_MEMO_TIMEOUT) {
+        timeout_count++;
+    }
+    else if (req_state == GCOAP_MEMO_RESP) {
+        resp_count++;
+    }
+    _stats_changed();
+}
+
+/*
+ * Compares size and encode time for /cli/stats as SenML CBOR and JSON.
+ */
+static void _senml_compare(void)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    senml_record_t records[STATS_RECORDS];
+    const char *names[] = { "CBOR", "JSON" };
+
+    _stats_records(records);
+    for (unsigned i = 0; i < 2; i++) {
+        ssize_t len = 0;
+        uint32_t start = xtimer_now_usec();
+        for (unsigned rep = 0; rep < STATS_ENCODE_REPS; rep++) {
+            len = (i == 0)
+                ? senml_encode_cbor(buf, sizeof(buf), STATS_BASE_NAME, records,
+                                    STATS_RECORDS)
+                : senml_encode_json(buf, sizeof(buf), STATS_BASE_NAME, records,
+                                    STATS_RECORDS);
+        }
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if (len < 0) {
+            printf("SenML %s: buffer too small\n", names[i]);
+            continue;
+        }
+        printf("SenML %s: %3u bytes, %5lu ns per encode\n", names[i],
+               (unsigned)len,
+               (unsigned long)(((uint64_t)elapsed * 1000) / STATS_ENCODE_REPS));
+    }
+}
+
+static size_t _send(uint8_t *buf, size_t len, char *addr_str, char *port_str)
+{
+    sock_udp_ep_t remote;
+
+    if (!gcoap_cli_init_remote(&remote, addr_str, port_str)) {
+        return 0;
+    }
+    return gcoap_cli_send(buf, len, &remote, _resp_handler);
+}
+
 int gcoap_cli_cmd(int argc, char **argv)
 {
     /* Ordered like the RFC method code numbers, but off by 1. GET is code 0. */
@@ -247,11 +625,44 @@ int gcoap_cli_cmd(int argc, char **argv)
         goto end;
     }
 
+    if (strcmp(argv[1], "bench") == 0) {
+        return gcoap_cli_bench_cmd(argc, argv);
+    }
+
+    if (strcmp(argv[1], "observe") == 0) {
+        return gcoap_cli_observe_cmd(argc, argv);
+    }
+
+    if (strcmp(argv[1], "mget") == 0) {
+        return gcoap_cli_mget_cmd(argc, argv);
+    }
+
+    if (strcmp(argv[1], "notify") == 0) {
+        return _notify_cmd(argc, argv);
+    }
+
+    if (strcmp(argv[1], "proxy") == 0) {
+        return gcoap_cli_proxy_cmd(argc, argv);
+    }
+
+#ifdef MODULE_VFS
+    if (strcmp(argv[1], "batch") == 0) {
+        return gcoap_cli_batch_cmd(argc, argv);
+    }
+#endif
+
     if (strcmp(argv[1], "info") == 0) {
         uint8_t open_reqs = gcoap_op_state();
 
+        if (argc == 3 && strcmp(argv[2], "senml") == 0) {
+            _senml_compare();
+            return 0;
+        }
         printf("CoAP server is listening on port %u\n", GCOAP_PORT);
-        printf(" CLI requests sent: %u\n", req_count);
+        printf(" CLI requests sent: %lu\n", (unsigned long)req_count);
+        printf("    bytes sent: %lu\n", (unsigned long)req_bytes);
+        printf("     responses: %lu\n", (unsigned long)resp_count);
+        printf("      timeouts: %lu\n", (unsigned long)timeout_count);
         printf("CoAP open requests: %u\n", open_reqs);
         return 0;
     }
@@ -269,31 +680,62 @@ int gcoap_cli_cmd(int argc, char **argv)
 
     /* parse options */
     int apos          = 2;               /* position of address argument */
-    if (argc > apos && strcmp(argv[apos], "-b") == 0) {
-        apos++;
-        block_size = atoi(argv[apos]);
-        if (block_size) {
+    unsigned msg_type = COAP_TYPE_NON;
+    gcoap_cli_source_t source = GCOAP_CLI_SOURCE_TEXT;
+    char *src_arg = NULL;
+    while (argc > apos && argv[apos][0] == '-') {
+        if (strcmp(argv[apos], "-c") == 0) {
+            msg_type = COAP_TYPE_CON;
             apos++;
+            continue;
+        }
+        if (argc == apos + 1) {
+            printf("value for %s not provided\n", argv[apos]);
+            goto usage;
+        }
+        if (strcmp(argv[apos], "-b") == 0) {
+            block_size = atoi(argv[apos+1]);
+            if (!block_size) {
+                puts("block size not provided");
+                goto usage;
+            }
+        }
+        else if (strcmp(argv[apos], "-f") == 0 && code_pos != 0) {
+            source = GCOAP_CLI_SOURCE_FILE;
+            src_arg = argv[apos+1];
+        }
+        else if (strcmp(argv[apos], "-g") == 0 && code_pos != 0) {
+            source = GCOAP_CLI_SOURCE_GEN;
+            src_arg = argv[apos+1];
         }
         else {
-            puts("block size not provided");
             goto usage;
         }
-    }
-
-    unsigned msg_type = COAP_TYPE_NON;
-    if (argc > apos && strcmp(argv[apos], "-c") == 0) {
-        msg_type = COAP_TYPE_CON;
-        apos++;
+        apos += 2;
     }
 
     /*
      * "get" (code_pos 0) must have exactly apos + 3 arguments
      * while "post" (code_pos 1) and "put" (code_pos 2) and must have exactly
-     * apos + 4 arguments
+     * apos + 4 arguments, unless the payload is from a -f or -g source
      */
-    if (((argc == apos + 3) && (code_pos == 0)) ||
-        ((argc == apos + 4) && (code_pos != 0))) {
+    int payload_args = (code_pos == 0 || source != GCOAP_CLI_SOURCE_TEXT) ? 0 : 1;
+    if (argc == apos + 3 + payload_args) {
+        if (payload_args) {
+            src_arg = argv[apos+3];
+        }
+
+        /* use blockwise for a POST/PUT block size, or a large payload source */
+        if (code_pos != 0 && (block_size || source != GCOAP_CLI_SOURCE_TEXT)) {
+            if (gcoap_cli_block1_start(code_pos+1, msg_type,
+                                       block_size ? block_size : GCOAP_CLI_BLOCK1_SIZE,
+                                       argv[apos], argv[apos+1], argv[apos+2],
+                                       source, src_arg, _resp_handler) < 0) {
+                return 1;
+            }
+            return 0;
+        }
+
         gcoap_req_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE, code_pos+1, argv[apos+2]);
         coap_hdr_set_type(pdu.hdr, msg_type);
 
@@ -302,17 +744,23 @@ int gcoap_cli_cmd(int argc, char **argv)
             memcpy(_last_req_path, argv[apos+2], strlen(argv[apos+2]));
         }
 
-        size_t paylen = (argc == apos + 4) ? strlen(argv[apos+3]) : 0;
+        size_t paylen = src_arg ? strlen(src_arg) : 0;
         if (paylen) {
             coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
             len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
             if (pdu.payload_len >= paylen) {
-                memcpy(pdu.payload, argv[apos+3], paylen);
+                memcpy(pdu.payload, src_arg, paylen);
                 len += paylen;
             }
             else {
-                puts("gcoap_cli: msg buffer too small");
-                return 1;
+                /* too large for a single message; send blockwise */
+                if (gcoap_cli_block1_start(code_pos+1, msg_type,
+                                           GCOAP_CLI_BLOCK1_SIZE, argv[apos],
+                                           argv[apos+1], argv[apos+2], source,
+                                           src_arg, _resp_handler) < 0) {
+                    return 1;
+                }
+                return 0;
             }
         }
         else {
@@ -328,25 +776,6 @@ int gcoap_cli_cmd(int argc, char **argv)
         if (!_send(&buf[0], len, argv[apos], argv[apos+1])) {
             puts("gcoap_cli: msg send failed");
         }
-        else {
-            /* send Observe notification for /cli/stats */
-            switch (gcoap_obs_init(&pdu, &buf[0], GCOAP_PDU_BUF_SIZE,
-                    &_resources[0])) {
-            case GCOAP_OBS_INIT_OK:
-                DEBUG("gcoap_cli: creating /cli/stats notification\n");
-                coap_opt_add_format(&pdu, COAP_FORMAT_TEXT);
-                len = coap_opt_finish(&pdu, COAP_OPT_FINISH_PAYLOAD);
-                len += fmt_u16_dec((char *)pdu.payload, req_count);
-                gcoap_obs_send(&buf[0], len, &_resources[0]);
-                break;
-            case GCOAP_OBS_INIT_UNUSED:
-                DEBUG("gcoap_cli: no observer for /cli/stats\n");
-                break;
-            case GCOAP_OBS_INIT_ERR:
-                DEBUG("gcoap_cli: error initializing /cli/stats notification\n");
-                break;
-            }
-        }
         return 0;
     }
     else {
@@ -354,19 +783,29 @@ int gcoap_cli_cmd(int argc, char **argv)
     }
 
     end:
-    printf("usage: %s <get|post|put|info>\n", argv[0]);
+    printf("usage: %s <get|post|put|mget|bench|batch|observe|notify|proxy|"
+           "info>\n", argv[0]);
     return 1;
 
     usage:
-    printf("usage: %s <get|post|put> [-b size][-c] <addr>[%%iface] <port> <path> [data]\n",
-           argv[0]);
+    printf("usage: %s <get|post|put> [-b size][-c][-f file|-g size] <addr>[%%iface] "
+           "<port> <path> [data]\n", argv[0]);
     printf("Options\n");
-    printf("    -b size  Block size for GET request; power of 2 from 16 to 1024\n");
+    printf("    -b size  Block size; power of 2 from 16 to 1024\n");
     printf("    -c       Send confirmably\n");
+#ifdef MODULE_VFS
+    printf("    -f file  POST/PUT payload from VFS file\n");
+#endif
+    printf("    -g size  POST/PUT generated payload of size bytes\n");
     return 1;
 }
 
 void gcoap_cli_init(void)
 {
     gcoap_register_listener(&_listener);
+
+    _notify.pid = thread_create(_notify_stack, sizeof(_notify_stack),
+                                THREAD_PRIORITY_MAIN - 1,
+                                THREAD_CREATE_STACKTEST, _notify_thread, NULL,
+                                "cli_notify");
 }
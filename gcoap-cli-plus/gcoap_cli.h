@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI internal definitions, shared between CLI commands
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef GCOAP_CLI_H
+#define GCOAP_CLI_H
+
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default block size for a blockwise POST/PUT
+ */
+#ifndef GCOAP_CLI_BLOCK1_SIZE
+#define GCOAP_CLI_BLOCK1_SIZE   (64U)
+#endif
+
+/**
+ * @brief Source of the payload for a POST/PUT request
+ */
+typedef enum {
+    GCOAP_CLI_SOURCE_TEXT,      /**< text from the command line */
+    GCOAP_CLI_SOURCE_FILE,      /**< file from VFS */
+    GCOAP_CLI_SOURCE_GEN,       /**< generated content of a given size */
+} gcoap_cli_source_t;
+
+/**
+ * @brief Initializes a remote endpoint from CLI address and port strings
+ *
+ * @param[out] remote    endpoint to initialize
+ * @param[in]  addr_str  IPv6 address, optionally with %iface suffix; modified
+ * @param[in]  port_str  UDP port
+ *
+ * @return 1 on success
+ * @return 0 on failure; reason printed on the console
+ */
+int gcoap_cli_init_remote(sock_udp_ep_t *remote, char *addr_str, char *port_str);
+
+/**
+ * @brief Sends a request and counts it as sent by the CLI
+ *
+ * @param[in] buf           PDU buffer
+ * @param[in] len           length of PDU in @p buf
+ * @param[in] remote        destination endpoint
+ * @param[in] resp_handler  callback for the response
+ *
+ * @return length of the packet sent
+ * @return 0 if cannot send
+ */
+size_t gcoap_cli_send(const uint8_t *buf, size_t len, sock_udp_ep_t *remote,
+                      gcoap_resp_handler_t resp_handler);
+
+/**
+ * @brief Counts a request sent by the CLI without gcoap_cli_send()
+ *
+ * For requests sent from the CLI's own sockets, like Observe registrations.
+ *
+ * @param[in] bytes         length of the packet sent
+ */
+void gcoap_cli_count_req(size_t bytes);
+
+/**
+ * @brief Counts a response or timeout for a request sent by the CLI
+ *
+ * Call from each response handler for requests sent with gcoap_cli_send().
+ *
+ * @param[in] req_state     GCOAP_MEMO_RESP, GCOAP_MEMO_TIMEOUT or GCOAP_MEMO_ERR
+ */
+void gcoap_cli_count_resp(unsigned req_state);
+
+/**
+ * @brief Starts a blockwise POST/PUT, and sends the first block
+ *
+ * Following blocks are sent by gcoap_cli_block1_resp().
+ *
+ * @param[in] method        COAP_METHOD_POST or COAP_METHOD_PUT
+ * @param[in] msg_type      COAP_TYPE_CON or COAP_TYPE_NON
+ * @param[in] blksize       block size; power of 2 from 16 to 1024
+ * @param[in] addr_str      destination address, like gcoap_cli_init_remote()
+ * @param[in] port_str      destination port
+ * @param[in] path          resource path
+ * @param[in] source        source for the payload
+ * @param[in] src_arg       text, file path, or generated size, for @p source
+ * @param[in] resp_handler  callback for each response
+ *
+ * @return 0 on success
+ * @return -1 on failure; reason printed on the console
+ */
+int gcoap_cli_block1_start(unsigned method, unsigned msg_type, unsigned blksize,
+                           char *addr_str, char *port_str, const char *path,
+                           gcoap_cli_source_t source, const char *src_arg,
+                           gcoap_resp_handler_t resp_handler);
+
+/**
+ * @brief Handles a response for a blockwise POST/PUT
+ *
+ * Sends the next block for a 2.31 Continue response. Otherwise ends the
+ * upload, and prints the goodput if successful. Ignores a response that does
+ * not match the token of the block in flight.
+ *
+ * @return 1 if the response was consumed to send the next block
+ * @return 0 if the response should be handled as usual
+ */
+int gcoap_cli_block1_resp(unsigned req_state, coap_pkt_t *pdu,
+                          sock_udp_ep_t *remote);
+
+/**
+ * @brief Handler for the 'coap bench' command
+ */
+int gcoap_cli_bench_cmd(int argc, char **argv);
+
+/**
+ * @brief Handler for the 'coap observe' command
+ */
+int gcoap_cli_observe_cmd(int argc, char **argv);
+
+/**
+ * @brief Handler for the 'coap mget' command
+ */
+int gcoap_cli_mget_cmd(int argc, char **argv);
+
+/**
+ * @brief Handler for the 'coap batch' command; requires the vfs module
+ */
+int gcoap_cli_batch_cmd(int argc, char **argv);
+
+/**
+ * @brief Handler for the 'coap proxy' command
+ */
+int gcoap_cli_proxy_cmd(int argc, char **argv);
+
+#if defined(GCOAP_CLI_HOSTFS) || defined(DOXYGEN)
+/**
+ * @brief Mounts host files read-only at /host, on the native board
+ */
+void gcoap_cli_hostfs_init(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GCOAP_CLI_H */
+/** @} */
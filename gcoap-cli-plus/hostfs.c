@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Read-only VFS mount of host files, for the native board
+ *
+ * Lets 'coap batch' and the -f payload option read files from the host on
+ * native. A path below the mount point, like /host/reqs.txt, names a file
+ * relative to GCOAP_CLI_HOSTFS_ROOT on the host, by default the directory where
+ * the application was started. On open, the file is read whole into one of a
+ * few fixed buffers, so the host is not called again until the next open.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#ifdef GCOAP_CLI_HOSTFS
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "native_internal.h"
+#include "vfs.h"
+#include "gcoap_cli.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifndef GCOAP_CLI_HOSTFS_ROOT
+#define GCOAP_CLI_HOSTFS_ROOT       "."
+#endif
+
+/* Max size of a file */
+#ifndef GCOAP_CLI_HOSTFS_FILE_MAX
+#define GCOAP_CLI_HOSTFS_FILE_MAX   (8192U)
+#endif
+
+/* Max open files; one each for batch and block1 */
+#define HOSTFS_FILES                (2U)
+#define HOSTFS_PATH_MAX             (64U)
+
+typedef struct {
+    bool in_use;
+    size_t len;
+    uint8_t data[GCOAP_CLI_HOSTFS_FILE_MAX];
+} _hostfs_file_t;
+
+static _hostfs_file_t _files[HOSTFS_FILES];
+
+/*
+ * Reads the host file for a path below the mount point into file. Returns 0
+ * on success, or a negative errno.
+ */
+static int _load(_hostfs_file_t *file, const char *name)
+{
+    char path[HOSTFS_PATH_MAX];
+    int res = 0;
+
+    if (snprintf(path, sizeof(path), "%s%s", GCOAP_CLI_HOSTFS_ROOT, name)
+            >= (int)sizeof(path)) {
+        return -ENAMETOOLONG;
+    }
+
+    _native_syscall_enter();
+    FILE *host = real_fopen(path, "rb");
+    if (host == NULL) {
+        res = -ENOENT;
+        goto out;
+    }
+    file->len = real_fread(file->data, 1, sizeof(file->data), host);
+    /* a full buffer may mean the file is larger */
+    uint8_t extra;
+    if (file->len == sizeof(file->data) && real_fread(&extra, 1, 1, host) == 1) {
+        res = -EFBIG;
+    }
+    real_fclose(host);
+out:
+    _native_syscall_leave();
+    return res;
+}
+
+static int _open(vfs_file_t *filp, const char *name, int flags, mode_t mode,
+                 const char *abs_path)
+{
+    (void)mode;
+    (void)abs_path;
+    _hostfs_file_t *file = NULL;
+
+    if ((flags & O_ACCMODE) != O_RDONLY) {
+        return -EROFS;
+    }
+    for (unsigned i = 0; i < HOSTFS_FILES; i++) {
+        if (!_files[i].in_use) {
+            file = &_files[i];
+            break;
+        }
+    }
+    if (!file) {
+        return -ENFILE;
+    }
+
+    int res = _load(file, name);
+    if (res < 0) {
+        DEBUG("hostfs: unable to load %s: %d\n", name, res);
+        return res;
+    }
+    file->in_use = true;
+    filp->private_data.ptr = file;
+    return 0;
+}
+
+static int _close(vfs_file_t *filp)
+{
+    _hostfs_file_t *file = filp->private_data.ptr;
+
+    file->in_use = false;
+    return 0;
+}
+
+static ssize_t _read(vfs_file_t *filp, void *dest, size_t nbytes)
+{
+    _hostfs_file_t *file = filp->private_data.ptr;
+
+    if ((size_t)filp->pos >= file->len) {
+        return 0;
+    }
+    if (nbytes > file->len - filp->pos) {
+        nbytes = file->len - filp->pos;
+    }
+    memcpy(dest, &file->data[filp->pos], nbytes);
+    filp->pos += nbytes;
+    return nbytes;
+}
+
+static off_t _lseek(vfs_file_t *filp, off_t off, int whence)
+{
+    _hostfs_file_t *file = filp->private_data.ptr;
+
+    switch (whence) {
+    case SEEK_SET:
+        break;
+    case SEEK_CUR:
+        off += filp->pos;
+        break;
+    case SEEK_END:
+        off += file->len;
+        break;
+    default:
+        return -EINVAL;
+    }
+    if (off < 0) {
+        return -EINVAL;
+    }
+    filp->pos = off;
+    return off;
+}
+
+static const vfs_file_ops_t _file_ops = {
+    .open = _open,
+    .close = _close,
+    .read = _read,
+    .lseek = _lseek,
+};
+
+static const vfs_file_system_t _hostfs = {
+    .f_op = &_file_ops,
+};
+
+static vfs_mount_t _mount = {
+    .fs = &_hostfs,
+    .mount_point = "/host",
+};
+
+void gcoap_cli_hostfs_init(void)
+{
+    if (vfs_mount(&_mount) < 0) {
+        puts("hostfs: unable to mount /host");
+    }
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* GCOAP_CLI_HOSTFS */
@@ -24,6 +24,12 @@
 #include "net/gcoap.h"
 #include "kernel_types.h"
 #include "shell.h"
+#ifdef GCOAP_CLI_SLIP_RB
+#include "slip_rb.h"
+#endif
+#ifdef GCOAP_CLI_HOSTFS
+#include "gcoap_cli.h"
+#endif
 
 #define MAIN_QUEUE_SIZE (4)
 static msg_t _main_msg_queue[MAIN_QUEUE_SIZE];
@@ -33,6 +39,9 @@ extern void gcoap_cli_init(void);
 
 static const shell_command_t shell_commands[] = {
     { "coap", "CoAP example", gcoap_cli_cmd },
+#ifdef GCOAP_CLI_SLIP_RB
+    { "slip", "SLIP link statistics", slip_rb_cmd },
+#endif
     { NULL, NULL, NULL }
 };
 
@@ -40,6 +49,12 @@ int main(void)
 {
     /* for the thread running the shell */
     msg_init_queue(_main_msg_queue, MAIN_QUEUE_SIZE);
+#ifdef GCOAP_CLI_SLIP_RB
+    slip_rb_init();
+#endif
+#ifdef GCOAP_CLI_HOSTFS
+    gcoap_cli_hostfs_init();
+#endif
     gcoap_cli_init();
     puts("gcoap example app");
 
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI multicast GET, with responses aggregated by source
+ *
+ * gcoap matches a response to its request memo by remote endpoint as well as
+ * token. Responses to a multicast request come from unicast addresses, so gcoap
+ * would drop them. Like the Observe client, mget uses its own socket and builds
+ * and parses messages with nanocoap directly.
+ *
+ * Sends a single NON GET, then collects responses until the leisure window
+ * expires. See RFC 7252 Sec. 8.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "net/gcoap.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+#include "random.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+/* Default time to collect responses; DEFAULT_LEISURE in RFC 7252 */
+#ifndef GCOAP_CLI_MGET_LEISURE_MS
+#define GCOAP_CLI_MGET_LEISURE_MS   (5000U)
+#endif
+
+/* Max distinct responders tracked */
+#ifndef GCOAP_CLI_MGET_MAX
+#define GCOAP_CLI_MGET_MAX          (16U)
+#endif
+
+#define MGET_TOKENLEN               (4U)
+#define MGET_PAYLOAD_SHOW           (24U)
+
+typedef struct {
+    ipv6_addr_t addr;
+    uint8_t code;
+    unsigned dups;                  /* duplicate responses from source */
+    uint32_t latency_us;
+    char payload[MGET_PAYLOAD_SHOW + 1];
+} _responder_t;
+
+/* Used only from the CLI thread, but too large for its stack */
+static _responder_t _responders[GCOAP_CLI_MGET_MAX];
+
+/* Returns the responder entry for addr, or NULL if not found. */
+static _responder_t *_find(const ipv6_addr_t *addr, unsigned count)
+{
+    for (unsigned i = 0; i < count; i++) {
+        if (ipv6_addr_equal(&_responders[i].addr, addr)) {
+            return &_responders[i];
+        }
+    }
+    return NULL;
+}
+
+static void _print_table(unsigned count, unsigned ignored, uint32_t leisure_ms)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN];
+    unsigned dups = 0;
+
+    puts("  # source                                   code    ms dups payload");
+    for (unsigned i = 0; i < count; i++) {
+        _responder_t *resp = &_responders[i];
+
+        ipv6_addr_to_str(addr_str, &resp->addr, sizeof(addr_str));
+        printf("%3u %-40s %1u.%02u %5lu %4u %s\n", i + 1, addr_str,
+               resp->code >> 5, resp->code & 0x1F,
+               (unsigned long)(resp->latency_us / US_PER_MS), resp->dups,
+               resp->payload);
+        dups += resp->dups;
+    }
+    printf("mget: %u responders, %u duplicates in %lu ms\n", count, dups,
+           (unsigned long)leisure_ms);
+    if (ignored) {
+        /* may include repeats from a source not shown */
+        printf("mget: %u responses not shown; table full\n", ignored);
+    }
+}
+
+int gcoap_cli_mget_cmd(int argc, char **argv)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    uint8_t token[MGET_TOKENLEN];
+    uint32_t leisure_ms = GCOAP_CLI_MGET_LEISURE_MS;
+    sock_udp_ep_t remote;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_t sock;
+    int apos = 2;
+
+    if (argc > apos + 1 && strcmp(argv[apos], "-l") == 0) {
+        leisure_ms = strtoul(argv[apos+1], NULL, 10);
+        apos += 2;
+    }
+    if (argc != apos + 3 || leisure_ms == 0) {
+        printf("usage: %s mget [-l leisure] <group>[%%iface] <port> <path>\n",
+               argv[0]);
+        printf("Options\n");
+        printf("    -l leisure  ms to collect responses; default %u\n",
+               GCOAP_CLI_MGET_LEISURE_MS);
+        return 1;
+    }
+    char *path = argv[apos+2];
+
+    if (!gcoap_cli_init_remote(&remote, argv[apos], argv[apos+1])) {
+        return 1;
+    }
+    if (!ipv6_addr_is_multicast((ipv6_addr_t *)&remote.addr.ipv6[0])) {
+        puts("mget: address is not multicast");
+        return 1;
+    }
+    local.netif = remote.netif;
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("mget: unable to create socket");
+        return 1;
+    }
+
+    uint32_t token_val = random_uint32();
+    memcpy(token, &token_val, MGET_TOKENLEN);
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_NON, token,
+                             MGET_TOKENLEN, COAP_METHOD_GET, random_uint32());
+    bufpos += coap_opt_put_uri_path(bufpos, 0, path);
+
+    uint32_t start = xtimer_now_usec();
+    if (sock_udp_send(&sock, buf, bufpos - buf, &remote) < 0) {
+        puts("mget: send failed");
+        sock_udp_close(&sock);
+        return 1;
+    }
+
+    unsigned count = 0;
+    unsigned ignored = 0;
+    uint32_t leisure_us = leisure_ms * US_PER_MS;
+    for (;;) {
+        uint32_t elapsed = xtimer_now_usec() - start;
+        if (elapsed >= leisure_us) {
+            break;
+        }
+
+        sock_udp_ep_t src;
+        coap_pkt_t pdu;
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf),
+                                    leisure_us - elapsed, &src);
+        if (res <= 0) {
+            continue;
+        }
+        uint32_t latency = xtimer_now_usec() - start;
+
+        if (coap_parse(&pdu, buf, res) < 0
+                || coap_get_code_class(&pdu) == COAP_CLASS_REQ
+                || coap_get_token_len(&pdu) != MGET_TOKENLEN
+                || memcmp(pdu.token, token, MGET_TOKENLEN) != 0) {
+            DEBUG("mget: ignoring unexpected message\n");
+            continue;
+        }
+
+        ipv6_addr_t *addr = (ipv6_addr_t *)&src.addr.ipv6[0];
+        _responder_t *resp = _find(addr, count);
+        if (resp) {
+            resp->dups++;
+            continue;
+        }
+        if (count == GCOAP_CLI_MGET_MAX) {
+            ignored++;
+            continue;
+        }
+
+        resp = &_responders[count++];
+        memset(resp, 0, sizeof(*resp));
+        memcpy(&resp->addr, addr, sizeof(resp->addr));
+        resp->code = coap_get_code_raw(&pdu);
+        resp->latency_us = latency;
+        if (pdu.payload_len && coap_get_content_type(&pdu) == COAP_FORMAT_TEXT) {
+            size_t len = pdu.payload_len < MGET_PAYLOAD_SHOW
+                            ? pdu.payload_len : MGET_PAYLOAD_SHOW;
+            memcpy(resp->payload, pdu.payload, len);
+        }
+    }
+    sock_udp_close(&sock);
+
+    _print_table(count, ignored, leisure_ms);
+    return 0;
+}
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI Observe client, with notification statistics
+ *
+ * gcoap releases a request memo when the first response arrives, and so drops
+ * later notifications for the same token. So the Observe client uses its own
+ * socket and thread, and builds and parses messages with nanocoap directly.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "net/gcoap.h"
+#include "net/sock/udp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define OBS_TOKENLEN            (4U)
+#define OBS_PATH_MAX            (32U)
+#define OBS_RECV_TIMEOUT        (1U * US_PER_SEC)
+
+/* Observe option values for registration and deregistration, RFC 7641 */
+#define OBS_REGISTER            (0U)
+#define OBS_DEREGISTER          (1U)
+
+/* Notification freshness limits, RFC 7641 Sec. 3.4 */
+#define OBS_SEQ_HALF            (1UL << 23)
+#define OBS_FRESH_TIMEOUT       (128UL * US_PER_SEC)
+
+/* State for the single observation supported */
+static struct {
+    volatile bool running;
+    volatile bool stop;
+    bool quiet;
+    bool counter;               /* server's sequence increments by one */
+    sock_udp_ep_t remote;
+    char path[OBS_PATH_MAX];
+    uint8_t token[OBS_TOKENLEN];
+    uint16_t msgid;
+    /* statistics */
+    bool registered;
+    uint32_t start_us;
+    uint32_t last_us;
+    uint32_t last_seq;
+    uint32_t last_interval;
+    uint32_t jitter;            /* smoothed, RFC 3550 style */
+    unsigned notifications;
+    unsigned stale;
+    unsigned gaps;
+} _obs;
+
+static char _obs_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+
+/*
+ * Builds and sends a GET with the provided Observe value. A retransmission
+ * reuses the message ID of the original.
+ */
+static int _send_get(sock_udp_t *sock, unsigned observe, uint16_t msgid)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    uint8_t obs_val = observe;
+
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, _obs.token,
+                             OBS_TOKENLEN, COAP_METHOD_GET, msgid);
+    /* value 0 is encoded as an empty option */
+    bufpos += coap_put_option(bufpos, 0, COAP_OPT_OBSERVE, &obs_val,
+                              observe ? 1 : 0);
+    bufpos += coap_opt_put_uri_path(bufpos, COAP_OPT_OBSERVE, _obs.path);
+
+    int res = sock_udp_send(sock, buf, bufpos - buf, &_obs.remote);
+    if (res > 0) {
+        gcoap_cli_count_req(res);
+    }
+    return res;
+}
+
+/* Acknowledges a confirmable notification. */
+static void _send_ack(sock_udp_t *sock, coap_pkt_t *pdu, sock_udp_ep_t *remote)
+{
+    uint8_t buf[sizeof(coap_hdr_t)];
+
+    coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_ACK, NULL, 0, COAP_CODE_EMPTY,
+                   coap_get_id(pdu));
+    sock_udp_send(sock, buf, sizeof(buf), remote);
+}
+
+/* Rejects a confirmable notification we no longer want. */
+static void _send_rst(sock_udp_t *sock, coap_pkt_t *pdu, sock_udp_ep_t *remote)
+{
+    uint8_t buf[sizeof(coap_hdr_t)];
+
+    coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_RST, NULL, 0, COAP_CODE_EMPTY,
+                   coap_get_id(pdu));
+    sock_udp_send(sock, buf, sizeof(buf), remote);
+}
+
+/* Returns true if a notification is newer than the last, RFC 7641 Sec. 3.4 */
+static bool _is_fresh(uint32_t seq, uint32_t now)
+{
+    uint32_t v1 = _obs.last_seq;
+
+    return (v1 < seq && (seq - v1) < OBS_SEQ_HALF)
+            || (v1 > seq && (v1 - seq) > OBS_SEQ_HALF)
+            || (now - _obs.last_us) > OBS_FRESH_TIMEOUT;
+}
+
+/* Updates statistics for a notification. */
+static void _handle_notification(coap_pkt_t *pdu, uint32_t now)
+{
+    uint32_t seq = coap_get_observe(pdu);
+
+    if (_obs.notifications && !_is_fresh(seq, now)) {
+        _obs.stale++;
+        DEBUG("observe: stale notification %lu\n", (unsigned long)seq);
+        return;
+    }
+
+    if (_obs.notifications) {
+        uint32_t interval = now - _obs.last_us;
+        /* sequence is 24 bits; a gap means loss only for a counter, since a
+         * server like gcoap uses a timestamp */
+        uint32_t delta = (seq - _obs.last_seq) & 0xFFFFFF;
+        if (_obs.counter && delta > 1) {
+            _obs.gaps += delta - 1;
+        }
+        if (_obs.notifications > 1) {
+            int32_t diff = (int32_t)(interval - _obs.last_interval);
+            uint32_t absdiff = (diff < 0) ? -diff : diff;
+            _obs.jitter += ((int32_t)(absdiff - _obs.jitter)) / 16;
+        }
+        _obs.last_interval = interval;
+    }
+    _obs.notifications++;
+    _obs.last_seq = seq;
+    _obs.last_us = now;
+
+    if (!_obs.quiet) {
+        printf("observe: seq %lu, code %1u.%02u, %u bytes\n", (unsigned long)seq,
+               coap_get_code_class(pdu), coap_get_code_detail(pdu),
+               pdu->payload_len);
+        if (pdu->payload_len && coap_get_content_type(pdu) == COAP_FORMAT_TEXT) {
+            printf("%.*s\n", pdu->payload_len, (char *)pdu->payload);
+        }
+    }
+}
+
+static void *_observe_thread(void *arg)
+{
+    (void)arg;
+    sock_udp_t sock;
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+
+    if (sock_udp_create(&sock, &local, NULL, 0) < 0) {
+        puts("observe: unable to create socket");
+        _obs.running = false;
+        return NULL;
+    }
+
+    /* The registration is confirmable, so retransmit it until acknowledged,
+     * with exponential back-off, RFC 7252 Sec. 4.2 */
+    uint16_t reg_msgid = _obs.msgid++;
+    uint32_t reg_timeout = random_uint32_range(COAP_ACK_TIMEOUT * US_PER_SEC,
+                                               COAP_ACK_TIMEOUT * US_PER_SEC * 3 / 2);
+    unsigned reg_attempts = 0;
+    bool reg_acked = false;
+
+    if (_send_get(&sock, OBS_REGISTER, reg_msgid) < 0) {
+        puts("observe: registration send failed");
+        goto exit;
+    }
+
+    while (!_obs.stop) {
+        sock_udp_ep_t remote;
+        coap_pkt_t pdu;
+        bool reg_pending = !_obs.registered && !reg_acked;
+
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf),
+                                    reg_pending ? reg_timeout : OBS_RECV_TIMEOUT,
+                                    &remote);
+        if (res == -ETIMEDOUT && reg_pending) {
+            if (++reg_attempts > COAP_MAX_RETRANSMIT) {
+                puts("observe: no response to registration");
+                gcoap_cli_count_resp(GCOAP_MEMO_TIMEOUT);
+                goto exit;
+            }
+            reg_timeout *= 2;
+            _send_get(&sock, OBS_REGISTER, reg_msgid);
+            continue;
+        }
+        if (res <= 0) {
+            continue;
+        }
+        uint32_t now = xtimer_now_usec();
+
+        if (res == sizeof(coap_hdr_t) && coap_parse(&pdu, buf, res) >= 0
+                && coap_get_type(&pdu) == COAP_TYPE_ACK
+                && coap_get_id(&pdu) == reg_msgid) {
+            /* empty ACK; the server sends the response separately */
+            reg_acked = true;
+            continue;
+        }
+
+        if (coap_parse(&pdu, buf, res) < 0
+                || coap_get_code_class(&pdu) == COAP_CLASS_REQ
+                || coap_get_token_len(&pdu) != OBS_TOKENLEN
+                || memcmp(pdu.token, _obs.token, OBS_TOKENLEN) != 0) {
+            DEBUG("observe: ignoring unexpected message\n");
+            continue;
+        }
+
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            _send_ack(&sock, &pdu, &remote);
+        }
+
+        if (!coap_has_observe(&pdu)) {
+            printf("observe: response %1u.%02u without Observe; not registered\n",
+                   coap_get_code_class(&pdu), coap_get_code_detail(&pdu));
+            goto exit;
+        }
+        if (!_obs.registered) {
+            _obs.registered = true;
+            _obs.start_us = now;
+            gcoap_cli_count_resp(GCOAP_MEMO_RESP);
+            puts("observe: registered");
+        }
+        _handle_notification(&pdu, now);
+    }
+
+    /* Deregister explicitly, then reject any notification in flight. */
+    _send_get(&sock, OBS_DEREGISTER, _obs.msgid++);
+    for (;;) {
+        sock_udp_ep_t remote;
+        coap_pkt_t pdu;
+
+        ssize_t res = sock_udp_recv(&sock, buf, sizeof(buf), OBS_RECV_TIMEOUT,
+                                    &remote);
+        if (res <= 0 || coap_parse(&pdu, buf, res) < 0) {
+            break;
+        }
+        if (coap_get_type(&pdu) == COAP_TYPE_CON) {
+            _send_rst(&sock, &pdu, &remote);
+        }
+        if (!coap_has_observe(&pdu)) {
+            /* response to the deregistration */
+            break;
+        }
+    }
+    puts("observe: deregistered");
+
+    exit:
+    sock_udp_close(&sock);
+    _obs.registered = false;
+    _obs.running = false;
+    return NULL;
+}
+
+static void _print_stats(void)
+{
+    uint32_t elapsed = _obs.last_us - _obs.start_us;
+    uint32_t mean = (_obs.notifications > 1)
+                        ? elapsed / (_obs.notifications - 1) : 0;
+    uint64_t rate_x100 = elapsed
+                         ? ((uint64_t)(_obs.notifications - 1) * 100 * US_PER_SEC)
+                                / elapsed
+                         : 0;
+
+    printf("observe: %s %s\n", _obs.registered ? "observing" : "not observing",
+           _obs.path);
+    printf(" notifications: %u\n", _obs.notifications);
+    printf("         stale: %u\n", _obs.stale);
+    if (_obs.counter) {
+        printf("   missed seqs: %u\n", _obs.gaps);
+    }
+    printf("          rate: %lu.%02lu/s\n", (unsigned long)(rate_x100 / 100),
+           (unsigned long)(rate_x100 % 100));
+    printf(" mean interval: %lu ms\n", (unsigned long)(mean / 1000));
+    printf("        jitter: %lu ms\n", (unsigned long)(_obs.jitter / 1000));
+}
+
+int gcoap_cli_observe_cmd(int argc, char **argv)
+{
+    int apos = 2;
+
+    if (argc == 3 && strcmp(argv[2], "stats") == 0) {
+        _print_stats();
+        return 0;
+    }
+
+    if (argc == 3 && strcmp(argv[2], "stop") == 0) {
+        if (!_obs.running) {
+            puts("observe: not running");
+            return 1;
+        }
+        _obs.stop = true;
+        while (_obs.running) {
+            xtimer_usleep(100U * US_PER_MS);
+        }
+        _print_stats();
+        return 0;
+    }
+
+    bool quiet = false;
+    bool counter = false;
+    for (; argc > apos && argv[apos][0] == '-'; apos++) {
+        if (strcmp(argv[apos], "-q") == 0) {
+            quiet = true;
+        }
+        else if (strcmp(argv[apos], "-s") == 0) {
+            counter = true;
+        }
+        else {
+            goto usage;
+        }
+    }
+    if (argc != apos + 3) {
+        goto usage;
+    }
+    if (_obs.running) {
+        puts("observe: already running; use 'stop' first");
+        return 1;
+    }
+    if (strlen(argv[apos+2]) >= OBS_PATH_MAX) {
+        puts("observe: path too long");
+        return 1;
+    }
+
+    memset(&_obs, 0, sizeof(_obs));
+    if (!gcoap_cli_init_remote(&_obs.remote, argv[apos], argv[apos+1])) {
+        return 1;
+    }
+    strcpy(_obs.path, argv[apos+2]);
+    _obs.quiet = quiet;
+    _obs.counter = counter;
+    _obs.msgid = random_uint32();
+    uint32_t token = random_uint32();
+    memcpy(_obs.token, &token, OBS_TOKENLEN);
+
+    _obs.running = true;
+    if (thread_create(_obs_stack, sizeof(_obs_stack), THREAD_PRIORITY_MAIN - 1,
+                      THREAD_CREATE_STACKTEST, _observe_thread, NULL,
+                      "observe") <= KERNEL_PID_UNDEF) {
+        puts("observe: unable to start thread");
+        _obs.running = false;
+        return 1;
+    }
+    return 0;
+
+    usage:
+    printf("usage: %s observe [-q] [-s] <addr>[%%iface] <port> <path>\n",
+           argv[0]);
+    printf("       %s observe <stop|stats>\n", argv[0]);
+    printf("Options\n");
+    printf("    -q       Don't print each notification\n");
+    printf("    -s       Server's Observe value is a counter; count missed "
+           "values as loss\n");
+    return 1;
+}
@@ -0,0 +1,701 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       gcoap CLI caching forward proxy
+ *
+ * Forwards a GET request with a Proxy-Uri option for a coap:// resource, and
+ * caches the response. A cached response is fresh for its Max-Age, and then is
+ * revalidated upstream with its ETag.
+ *
+ * A gcoap resource handler does not know the client's endpoint, so it can't
+ * send a separate response. So the proxy receives requests on its own socket
+ * and thread. On a cache miss, it acknowledges a confirmable request at once,
+ * and sends the upstream request with gcoap. The upstream response handler, in
+ * the gcoap thread, then sends a separate response to each client waiting for
+ * the resource. A request for a resource already being fetched waits for the
+ * same upstream response, so concurrent identical requests collapse into a
+ * single upstream request.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "net/sock/udp.h"
+#include "random.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "gcoap_cli.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#ifndef GCOAP_CLI_PROXY_PORT
+#define GCOAP_CLI_PROXY_PORT        (5685U)
+#endif
+
+#ifndef GCOAP_CLI_PROXY_CACHE_SIZE
+#define GCOAP_CLI_PROXY_CACHE_SIZE  (4U)
+#endif
+
+#ifndef GCOAP_CLI_PROXY_PAYLOAD_MAX
+#define GCOAP_CLI_PROXY_PAYLOAD_MAX (64U)
+#endif
+
+/* Client requests waiting for an upstream response, for all resources */
+#ifndef GCOAP_CLI_PROXY_WAITERS
+#define GCOAP_CLI_PROXY_WAITERS     (4U)
+#endif
+
+#define PROXY_URI_MAX           (64U)
+#define PROXY_ETAG_MAX          (8U)
+#define PROXY_TOKEN_MAX         (8U)
+#define PROXY_TOKENLEN          (4U)
+#define PROXY_SCHEME            "coap://"
+
+/* Default Max-Age for a response, RFC 7252 Sec. 5.10.5 */
+#define PROXY_MAX_AGE_DEFAULT   (60U)
+
+#define PROXY_PAYLOAD_MARKER    (0xFFU)
+
+/* Cached response for a Proxy-Uri */
+typedef struct {
+    char uri[PROXY_URI_MAX];            /* empty if unused */
+    uint8_t code;
+    uint16_t format;
+    uint8_t etag[PROXY_ETAG_MAX];
+    uint8_t etag_len;
+    uint8_t payload[GCOAP_CLI_PROXY_PAYLOAD_MAX];
+    uint16_t payload_len;
+    uint64_t expires;                   /* usec */
+    uint64_t last_used;                 /* usec, for LRU replacement */
+    bool pending;                       /* upstream request in flight */
+    bool revalidate;                    /* in flight request has our ETag */
+    uint8_t token[PROXY_TOKENLEN];      /* of the upstream request */
+} _cache_entry_t;
+
+/* Client request waiting for an upstream response */
+typedef struct {
+    _cache_entry_t *entry;              /* NULL if unused */
+    sock_udp_ep_t remote;
+    uint8_t token[PROXY_TOKEN_MAX];
+    uint8_t token_len;
+    uint8_t etag[PROXY_ETAG_MAX];       /* client's cached ETag, if any */
+    uint8_t etag_len;
+} _waiter_t;
+
+/* Fields of a response to a client, from the cache or from upstream */
+typedef struct {
+    uint8_t code;
+    uint16_t format;
+    const uint8_t *etag;
+    uint8_t etag_len;
+    uint32_t max_age;
+    const uint8_t *payload;
+    uint16_t payload_len;
+} _resp_t;
+
+static _cache_entry_t _cache[GCOAP_CLI_PROXY_CACHE_SIZE];
+static _waiter_t _waiters[GCOAP_CLI_PROXY_WAITERS];
+
+/* State shared between the proxy thread, the gcoap thread and the shell */
+static struct {
+    mutex_t lock;
+    bool enabled;
+    kernel_pid_t pid;
+    sock_udp_t sock;
+    uint16_t msgid;
+    unsigned requests;
+    unsigned hits;
+    unsigned misses;
+    unsigned collapsed;         /* misses served by a fetch in flight */
+    unsigned revalidated;       /* stale entries confirmed by upstream 2.03 */
+    unsigned uncached;          /* responses too large to cache */
+    unsigned upstream;
+    unsigned upstream_failed;
+    unsigned evictions;
+} _proxy = { .lock = MUTEX_INIT, .pid = KERNEL_PID_UNDEF };
+
+static char _proxy_stack[THREAD_STACKSIZE_DEFAULT + DEBUG_EXTRA_STACKSIZE];
+
+static _cache_entry_t *_cache_find(const char *uri)
+{
+    for (unsigned i = 0; i < GCOAP_CLI_PROXY_CACHE_SIZE; i++) {
+        if (strcmp(_cache[i].uri, uri) == 0) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Finds an unused entry, or else the least recently used that is not waiting
+ * for an upstream response. Returns NULL if all are waiting.
+ */
+static _cache_entry_t *_cache_alloc(void)
+{
+    _cache_entry_t *lru = NULL;
+
+    for (unsigned i = 0; i < GCOAP_CLI_PROXY_CACHE_SIZE; i++) {
+        if (_cache[i].uri[0] == '\0') {
+            return &_cache[i];
+        }
+        if (!_cache[i].pending
+                && (!lru || _cache[i].last_used < lru->last_used)) {
+            lru = &_cache[i];
+        }
+    }
+    if (lru) {
+        _proxy.evictions++;
+    }
+    return lru;
+}
+
+static _waiter_t *_waiter_alloc(void)
+{
+    for (unsigned i = 0; i < GCOAP_CLI_PROXY_WAITERS; i++) {
+        if (!_waiters[i].entry) {
+            return &_waiters[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Splits a "coap://[addr]:port/path" URI into a remote endpoint and path.
+ * Returns a pointer to the path within uri, or NULL on failure.
+ */
+static const char *_parse_uri(const char *uri, sock_udp_ep_t *remote)
+{
+    char addr_str[IPV6_ADDR_MAX_STR_LEN + 6];  /* allow for %iface */
+    char port_str[6] = "5683";
+
+    if (strncmp(uri, PROXY_SCHEME, strlen(PROXY_SCHEME)) != 0) {
+        return NULL;
+    }
+    const char *host = uri + strlen(PROXY_SCHEME);
+    if (*host != '[') {
+        return NULL;
+    }
+    host++;
+    const char *host_end = strchr(host, ']');
+    if (!host_end || (size_t)(host_end - host) >= sizeof(addr_str)) {
+        return NULL;
+    }
+    memcpy(addr_str, host, host_end - host);
+    addr_str[host_end - host] = '\0';
+
+    const char *path = strchr(host_end, '/');
+    if (!path) {
+        return NULL;
+    }
+    if (host_end[1] == ':') {
+        size_t port_len = path - (host_end + 2);
+        if (port_len == 0 || port_len >= sizeof(port_str)) {
+            return NULL;
+        }
+        memcpy(port_str, host_end + 2, port_len);
+        port_str[port_len] = '\0';
+    }
+
+    if (!gcoap_cli_init_remote(remote, addr_str, port_str)) {
+        return NULL;
+    }
+    return path;
+}
+
+/* Writes an option with a uint value, in the fewest bytes. */
+static size_t _put_uint_opt(uint8_t *buf, uint16_t lastonum, uint16_t onum,
+                            uint32_t value)
+{
+    uint8_t bytes[4];
+    unsigned len = 0;
+
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        if (len || (value >> shift) & 0xFF) {
+            bytes[len++] = (value >> shift) & 0xFF;
+        }
+    }
+    return coap_put_option(buf, lastonum, onum, bytes, len);
+}
+
+/*
+ * Writes a response to a client into buf, with the client's token. An ACK
+ * carries a piggybacked response. Returns the length of the message, or 0 if
+ * it does not fit.
+ */
+static size_t _write_resp(uint8_t *buf, size_t len, unsigned type,
+                          uint16_t msgid, const uint8_t *token,
+                          unsigned token_len, const _resp_t *resp)
+{
+    /* header and token, options of up to 3 + 8 bytes, and the marker */
+    if (sizeof(coap_hdr_t) + token_len + 3 * 3 + PROXY_ETAG_MAX + 4 + 1
+            + resp->payload_len > len) {
+        return 0;
+    }
+
+    uint8_t *bufpos = buf;
+    uint16_t lastonum = 0;
+
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, type, (uint8_t *)token,
+                             token_len, resp->code, msgid);
+    if (resp->etag_len) {
+        bufpos += coap_put_option(bufpos, lastonum, COAP_OPT_ETAG,
+                                  (uint8_t *)resp->etag, resp->etag_len);
+        lastonum = COAP_OPT_ETAG;
+    }
+    if (resp->format != COAP_FORMAT_NONE) {
+        bufpos += _put_uint_opt(bufpos, lastonum, COAP_OPT_CONTENT_FORMAT,
+                                resp->format);
+        lastonum = COAP_OPT_CONTENT_FORMAT;
+    }
+    bufpos += _put_uint_opt(bufpos, lastonum, COAP_OPT_MAX_AGE, resp->max_age);
+    if (resp->payload_len) {
+        *bufpos++ = PROXY_PAYLOAD_MARKER;
+        memcpy(bufpos, resp->payload, resp->payload_len);
+        bufpos += resp->payload_len;
+    }
+    return bufpos - buf;
+}
+
+/* Sends a response without options or payload. */
+static void _send_code(unsigned type, uint16_t msgid, const uint8_t *token,
+                       unsigned token_len, unsigned code,
+                       const sock_udp_ep_t *remote)
+{
+    uint8_t buf[sizeof(coap_hdr_t) + PROXY_TOKEN_MAX];
+
+    size_t len = coap_build_hdr((coap_hdr_t *)buf, type, (uint8_t *)token,
+                                token_len, code, msgid);
+    sock_udp_send(&_proxy.sock, buf, len, remote);
+}
+
+/* Reads the fields of a response from a cache entry. */
+static void _resp_from_entry(_resp_t *resp, const _cache_entry_t *entry,
+                             bool valid)
+{
+    uint64_t now = xtimer_now_usec64();
+
+    resp->code = valid ? COAP_CODE_VALID : entry->code;
+    resp->format = valid ? COAP_FORMAT_NONE : entry->format;
+    resp->etag = entry->etag;
+    resp->etag_len = entry->etag_len;
+    resp->max_age = (entry->expires > now)
+                        ? (entry->expires - now) / US_PER_SEC : 0;
+    resp->payload = entry->payload;
+    resp->payload_len = valid ? 0 : entry->payload_len;
+}
+
+/* Returns true if a client's ETag matches the cached representation. */
+static bool _etag_valid(const _cache_entry_t *entry, const uint8_t *etag,
+                        unsigned etag_len)
+{
+    return entry->etag_len && etag_len == entry->etag_len
+            && memcmp(etag, entry->etag, etag_len) == 0;
+}
+
+/*
+ * Sends a separate response to each client waiting for entry, and releases
+ * them. The response is resp if given, or else is read from the entry. Call
+ * with the lock held.
+ */
+static void _resp_waiters(_cache_entry_t *entry, const _resp_t *resp)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+
+    for (unsigned i = 0; i < GCOAP_CLI_PROXY_WAITERS; i++) {
+        _waiter_t *waiter = &_waiters[i];
+        if (waiter->entry != entry) {
+            continue;
+        }
+        _resp_t out;
+        if (resp) {
+            out = *resp;
+        }
+        else {
+            _resp_from_entry(&out, entry,
+                             _etag_valid(entry, waiter->etag, waiter->etag_len));
+        }
+
+        /* the request was acknowledged already, so respond non-confirmably */
+        size_t len = _write_resp(buf, sizeof(buf), COAP_TYPE_NON, _proxy.msgid++,
+                                 waiter->token, waiter->token_len, &out);
+        if (len) {
+            sock_udp_send(&_proxy.sock, buf, len, &waiter->remote);
+        }
+        else {
+            _send_code(COAP_TYPE_NON, _proxy.msgid++, waiter->token,
+                       waiter->token_len, COAP_CODE_INTERNAL_SERVER_ERROR,
+                       &waiter->remote);
+        }
+        waiter->entry = NULL;
+    }
+}
+
+static _cache_entry_t *_find_pending(coap_pkt_t *pdu)
+{
+    unsigned token_len = coap_get_token_len(pdu);
+    uint8_t *token = coap_hdr_data_ptr(pdu->hdr);
+
+    if (token_len != PROXY_TOKENLEN) {
+        return NULL;
+    }
+    for (unsigned i = 0; i < GCOAP_CLI_PROXY_CACHE_SIZE; i++) {
+        if (_cache[i].pending && memcmp(_cache[i].token, token, token_len) == 0) {
+            return &_cache[i];
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Upstream response handler. Runs in the gcoap thread. Updates the cache, and
+ * responds to the waiting clients.
+ */
+static void _upstream_handler(unsigned req_state, coap_pkt_t *pdu,
+                              sock_udp_ep_t *remote)
+{
+    (void)remote;
+
+    mutex_lock(&_proxy.lock);
+    _cache_entry_t *entry = _find_pending(pdu);
+    if (!entry) {
+        DEBUG("proxy: unexpected upstream response\n");
+        mutex_unlock(&_proxy.lock);
+        return;
+    }
+    entry->pending = false;
+
+    if (req_state != GCOAP_MEMO_RESP) {
+        DEBUG("proxy: upstream request failed: %u\n", req_state);
+        _proxy.upstream_failed++;
+        _resp_t resp = { .code = COAP_CODE_GATEWAY_TIMEOUT,
+                         .format = COAP_FORMAT_NONE };
+        _resp_waiters(entry, &resp);
+        entry->uri[0] = '\0';
+        mutex_unlock(&_proxy.lock);
+        return;
+    }
+
+    uint32_t max_age;
+    if (coap_opt_get_uint(pdu, COAP_OPT_MAX_AGE, &max_age) < 0) {
+        max_age = PROXY_MAX_AGE_DEFAULT;
+    }
+    entry->expires = xtimer_now_usec64() + (uint64_t)max_age * US_PER_SEC;
+
+    if (coap_get_code_raw(pdu) == COAP_CODE_VALID && entry->revalidate) {
+        /* cached representation is still good */
+        _proxy.revalidated++;
+        _resp_waiters(entry, NULL);
+        mutex_unlock(&_proxy.lock);
+        return;
+    }
+
+    entry->code = coap_get_code_raw(pdu);
+    entry->format = coap_get_content_type(pdu);
+    uint8_t *etag = NULL;
+    ssize_t etag_len = coap_opt_get_opaque(pdu, COAP_OPT_ETAG, &etag);
+    if (etag_len > 0 && etag_len <= (ssize_t)PROXY_ETAG_MAX) {
+        memcpy(entry->etag, etag, etag_len);
+        entry->etag_len = etag_len;
+    }
+    else {
+        entry->etag_len = 0;
+    }
+
+    if (pdu->payload_len > GCOAP_CLI_PROXY_PAYLOAD_MAX) {
+        /* forward, but don't cache */
+        _proxy.uncached++;
+        _resp_t resp = { .code = entry->code, .format = entry->format,
+                         .etag = entry->etag, .etag_len = entry->etag_len,
+                         .max_age = max_age, .payload = pdu->payload,
+                         .payload_len = pdu->payload_len };
+        _resp_waiters(entry, &resp);
+        entry->uri[0] = '\0';
+        mutex_unlock(&_proxy.lock);
+        return;
+    }
+    if (max_age == 0) {
+        /* can't cache; mark as expired so it is fetched next time */
+        entry->expires = 0;
+    }
+    entry->payload_len = pdu->payload_len;
+    memcpy(entry->payload, pdu->payload, entry->payload_len);
+    _resp_waiters(entry, NULL);
+    mutex_unlock(&_proxy.lock);
+}
+
+/*
+ * Sends the upstream request for entry, revalidating with its ETag if entry is
+ * stale. Call with the lock held. Returns 0 on success, or -1 on failure.
+ */
+static int _fetch(_cache_entry_t *entry, bool revalidate)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t *bufpos = buf;
+    sock_udp_ep_t remote;
+    uint16_t lastonum = 0;
+
+    const char *path = _parse_uri(entry->uri, &remote);
+    if (!path) {
+        return -1;
+    }
+
+    uint32_t rand = random_uint32();
+    memcpy(entry->token, &rand, PROXY_TOKENLEN);
+    bufpos += coap_build_hdr((coap_hdr_t *)buf, COAP_TYPE_CON, entry->token,
+                             PROXY_TOKENLEN, COAP_METHOD_GET, _proxy.msgid++);
+    if (revalidate && entry->etag_len) {
+        bufpos += coap_put_option(bufpos, lastonum, COAP_OPT_ETAG, entry->etag,
+                                  entry->etag_len);
+        lastonum = COAP_OPT_ETAG;
+    }
+    bufpos += coap_opt_put_uri_path(bufpos, lastonum, path);
+
+    /* mark as pending first, in case the response is fast */
+    entry->pending = true;
+    entry->revalidate = revalidate && entry->etag_len;
+    _proxy.upstream++;
+    if (!gcoap_req_send2(buf, bufpos - buf, &remote, _upstream_handler)) {
+        DEBUG("proxy: upstream send failed\n");
+        entry->pending = false;
+        _proxy.upstream_failed++;
+        return -1;
+    }
+    return 0;
+}
+
+/* Handles a request from a client. Runs in the proxy thread. */
+static void _handle_req(coap_pkt_t *pdu, const sock_udp_ep_t *remote)
+{
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+    uint8_t token[PROXY_TOKEN_MAX];
+    unsigned token_len = coap_get_token_len(pdu);
+    uint16_t msgid = coap_get_id(pdu);
+    /* a response to a CON request is piggybacked on the ACK */
+    unsigned type = (coap_get_type(pdu) == COAP_TYPE_CON) ? COAP_TYPE_ACK
+                                                           : COAP_TYPE_NON;
+    uint8_t *uri;
+    uint8_t *etag = NULL;
+
+    if (token_len > PROXY_TOKEN_MAX) {
+        return;
+    }
+    memcpy(token, coap_hdr_data_ptr(pdu->hdr), token_len);
+
+    ssize_t uri_len = coap_opt_get_opaque(pdu, COAP_OPT_PROXY_URI, &uri);
+    if (coap_get_code_raw(pdu) != COAP_METHOD_GET) {
+        _send_code(type, msgid, token, token_len, COAP_CODE_METHOD_NOT_ALLOWED,
+                   remote);
+        return;
+    }
+    if (uri_len <= 0) {
+        _send_code(type, msgid, token, token_len, COAP_CODE_PATH_NOT_FOUND,
+                   remote);
+        return;
+    }
+    if (!_proxy.enabled) {
+        _send_code(type, msgid, token, token_len,
+                   COAP_CODE_PROXYING_NOT_SUPPORTED, remote);
+        return;
+    }
+    if ((size_t)uri_len >= PROXY_URI_MAX) {
+        _send_code(type, msgid, token, token_len, COAP_CODE_BAD_OPTION, remote);
+        return;
+    }
+    char uri_str[PROXY_URI_MAX];
+    memcpy(uri_str, uri, uri_len);
+    uri_str[uri_len] = '\0';
+
+    /* client may validate its own cached copy */
+    ssize_t etag_len = coap_opt_get_opaque(pdu, COAP_OPT_ETAG, &etag);
+    if (etag_len < 0 || etag_len > (ssize_t)PROXY_ETAG_MAX) {
+        etag_len = 0;
+    }
+
+    mutex_lock(&_proxy.lock);
+    _proxy.requests++;
+    uint64_t now = xtimer_now_usec64();
+    _cache_entry_t *entry = _cache_find(uri_str);
+
+    if (entry && !entry->pending && entry->expires > now) {
+        _proxy.hits++;
+        entry->last_used = now;
+
+        _resp_t resp;
+        _resp_from_entry(&resp, entry, _etag_valid(entry, etag, etag_len));
+        size_t len = _write_resp(buf, sizeof(buf), type, msgid, token,
+                                 token_len, &resp);
+        mutex_unlock(&_proxy.lock);
+        if (len) {
+            sock_udp_send(&_proxy.sock, buf, len, remote);
+        }
+        else {
+            _send_code(type, msgid, token, token_len,
+                       COAP_CODE_INTERNAL_SERVER_ERROR, remote);
+        }
+        return;
+    }
+
+    _proxy.misses++;
+    unsigned code = 0;
+    _waiter_t *waiter = _waiter_alloc();
+    if (!waiter) {
+        code = COAP_CODE_SERVICE_UNAVAILABLE;
+    }
+    else if (entry && entry->pending) {
+        _proxy.collapsed++;
+    }
+    else {
+        bool revalidate = (entry != NULL);
+        if (!entry) {
+            entry = _cache_alloc();
+            if (entry) {
+                memcpy(entry->uri, uri_str, uri_len + 1);
+                entry->etag_len = 0;
+            }
+        }
+        if (!entry) {
+            code = COAP_CODE_SERVICE_UNAVAILABLE;
+        }
+        else if (_fetch(entry, revalidate) < 0) {
+            entry->uri[0] = '\0';
+            code = COAP_CODE_BAD_GATEWAY;
+        }
+    }
+
+    if (code) {
+        mutex_unlock(&_proxy.lock);
+        _send_code(type, msgid, token, token_len, code, remote);
+        return;
+    }
+    entry->last_used = now;
+    waiter->entry = entry;
+    waiter->remote = *remote;
+    memcpy(waiter->token, token, token_len);
+    waiter->token_len = token_len;
+    memcpy(waiter->etag, etag, etag_len);
+    waiter->etag_len = etag_len;
+    mutex_unlock(&_proxy.lock);
+
+    if (type == COAP_TYPE_ACK) {
+        /* empty ACK; the response follows separately */
+        _send_code(COAP_TYPE_ACK, msgid, NULL, 0, COAP_CODE_EMPTY, remote);
+    }
+}
+
+static void *_proxy_thread(void *arg)
+{
+    (void)arg;
+    uint8_t buf[GCOAP_PDU_BUF_SIZE];
+
+    while (1) {
+        sock_udp_ep_t remote;
+        coap_pkt_t pdu;
+
+        ssize_t res = sock_udp_recv(&_proxy.sock, buf, sizeof(buf),
+                                    SOCK_NO_TIMEOUT, &remote);
+        if (res <= 0 || coap_parse(&pdu, buf, res) < 0
+                || coap_get_code_class(&pdu) != COAP_CLASS_REQ) {
+            /* ignore ACK/RST for our responses too */
+            continue;
+        }
+        _handle_req(&pdu, &remote);
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+/* Creates the proxy socket and thread, on first use. */
+static int _start(void)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+
+    if (_proxy.pid != KERNEL_PID_UNDEF) {
+        return 0;
+    }
+    local.port = GCOAP_CLI_PROXY_PORT;
+    if (sock_udp_create(&_proxy.sock, &local, NULL, 0) < 0) {
+        puts("proxy: unable to create socket");
+        return -1;
+    }
+    _proxy.msgid = random_uint32();
+    _proxy.pid = thread_create(_proxy_stack, sizeof(_proxy_stack),
+                               THREAD_PRIORITY_MAIN - 1, THREAD_CREATE_STACKTEST,
+                               _proxy_thread, NULL, "proxy");
+    if (_proxy.pid <= KERNEL_PID_UNDEF) {
+        puts("proxy: unable to start thread");
+        sock_udp_close(&_proxy.sock);
+        _proxy.pid = KERNEL_PID_UNDEF;
+        return -1;
+    }
+    return 0;
+}
+
+int gcoap_cli_proxy_cmd(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[2], "on") == 0) {
+        if (_start() < 0) {
+            return 1;
+        }
+        _proxy.enabled = true;
+        printf("proxy: listening on port %u\n", GCOAP_CLI_PROXY_PORT);
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[2], "off") == 0) {
+        _proxy.enabled = false;
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[2], "flush") == 0) {
+        mutex_lock(&_proxy.lock);
+        for (unsigned i = 0; i < GCOAP_CLI_PROXY_CACHE_SIZE; i++) {
+            /* an entry in flight is released by its upstream response */
+            if (!_cache[i].pending) {
+                memset(&_cache[i], 0, sizeof(_cache[i]));
+            }
+        }
+        mutex_unlock(&_proxy.lock);
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[2], "stats") == 0) {
+        mutex_lock(&_proxy.lock);
+        unsigned ratio = _proxy.requests ? (_proxy.hits * 100) / _proxy.requests : 0;
+
+        printf("proxy: %s, port %u, cache size %u\n",
+               _proxy.enabled ? "on" : "off", GCOAP_CLI_PROXY_PORT,
+               GCOAP_CLI_PROXY_CACHE_SIZE);
+        printf("          requests: %u\n", _proxy.requests);
+        printf("        cache hits: %u (%u%%)\n", _proxy.hits, ratio);
+        printf("      cache misses: %u (%u collapsed)\n", _proxy.misses,
+               _proxy.collapsed);
+        printf("       revalidated: %u\n", _proxy.revalidated);
+        printf("          uncached: %u\n", _proxy.uncached);
+        printf("         evictions: %u\n", _proxy.evictions);
+        printf(" upstream requests: %u (%u failed)\n", _proxy.upstream,
+               _proxy.upstream_failed);
+        printf("    upstream saved: %u\n", _proxy.requests - _proxy.upstream);
+        mutex_unlock(&_proxy.lock);
+        return 0;
+    }
+
+    printf("usage: %s proxy <on|off|flush|stats>\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Tracks outstanding gcoap requests for a CLI command
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "msg.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+#include "thread.h"
+#include "xtimer.h"
+#include "reqtrack.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+void reqtrack_reset(reqtrack_t *track)
+{
+    mutex_lock(&track->lock);
+    memset(track->slots, 0, sizeof(track->slots));
+    track->outstanding = 0;
+    track->waiter = thread_getpid();
+    mutex_unlock(&track->lock);
+}
+
+reqtrack_slot_t *reqtrack_add(reqtrack_t *track, coap_pkt_t *pdu, void *ctx)
+{
+    reqtrack_slot_t *slot = NULL;
+
+    mutex_lock(&track->lock);
+    for (unsigned i = 0; i < REQTRACK_SLOTS_MAX; i++) {
+        if (!track->slots[i].in_use) {
+            slot = &track->slots[i];
+            break;
+        }
+    }
+    if (slot) {
+        slot->in_use = true;
+        slot->token_len = coap_get_token_len(pdu);
+        memcpy(slot->token, coap_hdr_data_ptr(pdu->hdr), slot->token_len);
+        slot->sent_us = xtimer_now_usec();
+        slot->ctx = ctx;
+        track->outstanding++;
+    }
+    mutex_unlock(&track->lock);
+    return slot;
+}
+
+void reqtrack_remove(reqtrack_t *track, reqtrack_slot_t *slot)
+{
+    mutex_lock(&track->lock);
+    slot->in_use = false;
+    track->outstanding--;
+    mutex_unlock(&track->lock);
+}
+
+reqtrack_slot_t *reqtrack_find(reqtrack_t *track, coap_pkt_t *pdu)
+{
+    unsigned token_len = coap_get_token_len(pdu);
+    uint8_t *token = coap_hdr_data_ptr(pdu->hdr);
+
+    for (unsigned i = 0; i < REQTRACK_SLOTS_MAX; i++) {
+        reqtrack_slot_t *slot = &track->slots[i];
+        if (slot->in_use && slot->token_len == token_len
+                && memcmp(slot->token, token, token_len) == 0) {
+            return slot;
+        }
+    }
+    return NULL;
+}
+
+void reqtrack_done(reqtrack_t *track, reqtrack_slot_t *slot)
+{
+    slot->in_use = false;
+    track->outstanding--;
+    kernel_pid_t waiter = track->waiter;
+    mutex_unlock(&track->lock);
+
+    msg_t msg = { .type = REQTRACK_MSG_TYPE_DONE };
+    msg_try_send(&msg, waiter);
+}
+
+unsigned reqtrack_outstanding(reqtrack_t *track)
+{
+    mutex_lock(&track->lock);
+    unsigned outstanding = track->outstanding;
+    mutex_unlock(&track->lock);
+    return outstanding;
+}
+
+void reqtrack_wait(uint32_t timeout)
+{
+    msg_t msg;
+
+    if (xtimer_msg_receive_timeout(&msg, timeout) >= 0
+            && msg.type != REQTRACK_MSG_TYPE_DONE) {
+        DEBUG("reqtrack: ignoring msg type %u\n", msg.type);
+    }
+}
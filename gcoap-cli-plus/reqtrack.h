@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Tracks outstanding gcoap requests for a CLI command
+ *
+ * A command that keeps several requests outstanding, like 'coap bench' and
+ * 'coap batch', sends from the CLI thread, while its response callback runs in
+ * the gcoap thread. The tracker matches a response to its request by token,
+ * and wakes the CLI thread with a message when a request completes.
+ *
+ * The tracker's lock also guards the command's own state for the requests. A
+ * response callback looks like:
+ *
+ *     mutex_lock(&track.lock);
+ *     reqtrack_slot_t *slot = reqtrack_find(&track, pdu);
+ *     if (!slot) {
+ *         mutex_unlock(&track.lock);
+ *         return;
+ *     }
+ *     ...record the response...
+ *     reqtrack_done(&track, slot);
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef REQTRACK_H
+#define REQTRACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "kernel_types.h"
+#include "mutex.h"
+#include "net/gcoap.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Max outstanding requests, limited by gcoap's memo table
+ */
+#define REQTRACK_SLOTS_MAX      (GCOAP_REQ_WAITING_MAX)
+
+/**
+ * @brief Message type to wake the waiting thread when a request completes
+ */
+#define REQTRACK_MSG_TYPE_DONE  (0x3301)
+
+/**
+ * @brief An outstanding request
+ */
+typedef struct {
+    bool in_use;                    /**< true if outstanding */
+    uint8_t token_len;              /**< length of token */
+    uint8_t token[GCOAP_TOKENLEN];  /**< request token */
+    uint32_t sent_us;               /**< time sent, from xtimer_now_usec() */
+    void *ctx;                      /**< command's own record for the request */
+} reqtrack_slot_t;
+
+/**
+ * @brief Outstanding requests for a command
+ *
+ * Initialize statically with `{ .lock = MUTEX_INIT }`.
+ */
+typedef struct {
+    mutex_t lock;                   /**< guards tracker and command state */
+    kernel_pid_t waiter;            /**< thread woken on completion */
+    unsigned outstanding;           /**< count of slots in use */
+    reqtrack_slot_t slots[REQTRACK_SLOTS_MAX];  /**< outstanding requests */
+} reqtrack_t;
+
+/**
+ * @brief Clears the tracker, and sets the calling thread as its waiter
+ *
+ * @param[in] track     tracker to reset
+ */
+void reqtrack_reset(reqtrack_t *track);
+
+/**
+ * @brief Adds a request before it is sent
+ *
+ * Call before sending, in case the response is fast.
+ *
+ * @param[in] track     tracker
+ * @param[in] pdu       request, with its token
+ * @param[in] ctx       command's own record for the request
+ *
+ * @return slot for the request
+ * @return NULL if all slots are in use
+ */
+reqtrack_slot_t *reqtrack_add(reqtrack_t *track, coap_pkt_t *pdu, void *ctx);
+
+/**
+ * @brief Removes a request that could not be sent
+ *
+ * @param[in] track     tracker
+ * @param[in] slot      slot from reqtrack_add()
+ */
+void reqtrack_remove(reqtrack_t *track, reqtrack_slot_t *slot);
+
+/**
+ * @brief Finds the request for a response or timeout
+ *
+ * Call with the tracker's lock held.
+ *
+ * @param[in] track     tracker
+ * @param[in] pdu       response, or request header on timeout
+ *
+ * @return slot for the request
+ * @return NULL if not found
+ */
+reqtrack_slot_t *reqtrack_find(reqtrack_t *track, coap_pkt_t *pdu);
+
+/**
+ * @brief Completes a request, releases the tracker's lock, and wakes the
+ *        waiter
+ *
+ * Call with the tracker's lock held.
+ *
+ * @param[in] track     tracker
+ * @param[in] slot      slot from reqtrack_find()
+ */
+void reqtrack_done(reqtrack_t *track, reqtrack_slot_t *slot);
+
+/**
+ * @brief Returns the count of outstanding requests
+ *
+ * @param[in] track     tracker
+ */
+unsigned reqtrack_outstanding(reqtrack_t *track);
+
+/**
+ * @brief Waits for a request to complete, or a timeout
+ *
+ * @param[in] timeout   max wait in usec
+ */
+void reqtrack_wait(uint32_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* REQTRACK_H */
+/** @} */
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Minimal SenML encoder for a pack of unsigned counters
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <string.h>
+#include "fmt.h"
+#include "senml.h"
+
+/* CBOR major types, RFC 7049 */
+#define CBOR_UINT           (0x00U)
+#define CBOR_NEGINT         (0x20U)
+#define CBOR_TEXT           (0x60U)
+#define CBOR_ARRAY          (0x80U)
+#define CBOR_MAP            (0xA0U)
+
+/* SenML CBOR labels, RFC 8428 Sec. 6 */
+#define SENML_LABEL_BN      (-2)
+#define SENML_LABEL_N       (0)
+#define SENML_LABEL_V       (2)
+
+/* Longest encoding of a CBOR unsigned integer */
+#define CBOR_UINT_MAX_LEN   (5U)
+
+/* Writes a CBOR head for a major type and argument. Returns length written. */
+static size_t _cbor_head(uint8_t *buf, uint8_t major, uint32_t arg)
+{
+    if (arg < 24) {
+        buf[0] = major | arg;
+        return 1;
+    }
+    if (arg <= 0xFF) {
+        buf[0] = major | 24;
+        buf[1] = arg;
+        return 2;
+    }
+    if (arg <= 0xFFFF) {
+        buf[0] = major | 25;
+        buf[1] = arg >> 8;
+        buf[2] = arg;
+        return 3;
+    }
+    buf[0] = major | 26;
+    buf[1] = arg >> 24;
+    buf[2] = arg >> 16;
+    buf[3] = arg >> 8;
+    buf[4] = arg;
+    return 5;
+}
+
+/* Writes a SenML label, which is a small signed integer. */
+static size_t _cbor_label(uint8_t *buf, int label)
+{
+    return (label < 0) ? _cbor_head(buf, CBOR_NEGINT, -1 - label)
+                       : _cbor_head(buf, CBOR_UINT, label);
+}
+
+/* Writes a label and a short text value; assumes room available. */
+static size_t _cbor_text_pair(uint8_t *buf, int label, const char *text)
+{
+    size_t text_len = strlen(text);
+    size_t pos = _cbor_label(buf, label);
+
+    pos += _cbor_head(&buf[pos], CBOR_TEXT, text_len);
+    memcpy(&buf[pos], text, text_len);
+    return pos + text_len;
+}
+
+ssize_t senml_encode_cbor(uint8_t *buf, size_t len, const char *base_name,
+                          const senml_record_t *records, unsigned count)
+{
+    size_t pos = 0;
+
+    /* array and map heads, labels and string heads are one byte each */
+    if (len < 1) {
+        return -1;
+    }
+    pos += _cbor_head(buf, CBOR_ARRAY, count);
+
+    for (unsigned i = 0; i < count; i++) {
+        size_t need = 1 + 2 + strlen(records[i].name) + 1 + CBOR_UINT_MAX_LEN;
+        if (i == 0) {
+            need += 2 + strlen(base_name);
+        }
+        if (len - pos < need) {
+            return -1;
+        }
+
+        pos += _cbor_head(&buf[pos], CBOR_MAP, (i == 0) ? 3 : 2);
+        if (i == 0) {
+            pos += _cbor_text_pair(&buf[pos], SENML_LABEL_BN, base_name);
+        }
+        pos += _cbor_text_pair(&buf[pos], SENML_LABEL_N, records[i].name);
+        pos += _cbor_label(&buf[pos], SENML_LABEL_V);
+        pos += _cbor_head(&buf[pos], CBOR_UINT, records[i].value);
+    }
+    return pos;
+}
+
+/* Appends a string, if there is room. Returns 0 on success. */
+static int _json_put(uint8_t *buf, size_t len, size_t *pos, const char *str)
+{
+    size_t str_len = strlen(str);
+
+    if (len - *pos < str_len) {
+        return -1;
+    }
+    memcpy(&buf[*pos], str, str_len);
+    *pos += str_len;
+    return 0;
+}
+
+ssize_t senml_encode_json(uint8_t *buf, size_t len, const char *base_name,
+                          const senml_record_t *records, unsigned count)
+{
+    char num[11];
+    size_t pos = 0;
+
+    if (_json_put(buf, len, &pos, "[")) {
+        return -1;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        if (i > 0 && _json_put(buf, len, &pos, ",")) {
+            return -1;
+        }
+        if (_json_put(buf, len, &pos, "{")) {
+            return -1;
+        }
+        if (i == 0 && (_json_put(buf, len, &pos, "\"bn\":\"")
+                        || _json_put(buf, len, &pos, base_name)
+                        || _json_put(buf, len, &pos, "\","))) {
+            return -1;
+        }
+        num[fmt_u32_dec(num, records[i].value)] = '\0';
+        if (_json_put(buf, len, &pos, "\"n\":\"")
+                || _json_put(buf, len, &pos, records[i].name)
+                || _json_put(buf, len, &pos, "\",\"v\":")
+                || _json_put(buf, len, &pos, num)
+                || _json_put(buf, len, &pos, "}")) {
+            return -1;
+        }
+    }
+    if (_json_put(buf, len, &pos, "]")) {
+        return -1;
+    }
+    return pos;
+}
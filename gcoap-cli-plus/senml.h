@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Minimal SenML encoder for a pack of unsigned counters
+ *
+ * Encodes a SenML pack (RFC 8428) in CBOR or JSON. Supports only what the
+ * gcoap CLI needs: a base name in the first record, and a name and unsigned
+ * integer value in each record.
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef SENML_H
+#define SENML_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @name    SenML content formats, RFC 8428 Sec. 12.3
+ * @{
+ */
+#define SENML_FORMAT_JSON   (110)
+#define SENML_FORMAT_CBOR   (112)
+/** @} */
+
+/**
+ * @brief A SenML record with an unsigned value
+ */
+typedef struct {
+    const char *name;       /**< record name; less than 24 characters */
+    uint32_t value;         /**< record value */
+} senml_record_t;
+
+/**
+ * @brief Encodes records as a SenML CBOR pack
+ *
+ * @param[out] buf       buffer for encoded pack
+ * @param[in]  len       length of @p buf
+ * @param[in]  base_name base name for the pack; less than 24 characters
+ * @param[in]  records   records to encode
+ * @param[in]  count     count of records; less than 24
+ *
+ * @return length of encoded pack
+ * @return -1 if @p buf too small
+ */
+ssize_t senml_encode_cbor(uint8_t *buf, size_t len, const char *base_name,
+                          const senml_record_t *records, unsigned count);
+
+/**
+ * @brief Encodes records as a SenML JSON pack
+ *
+ * Parameters and return value like senml_encode_cbor().
+ */
+ssize_t senml_encode_json(uint8_t *buf, size_t len, const char *base_name,
+                          const senml_record_t *records, unsigned count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENML_H */
+/** @} */
@@ -0,0 +1,328 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Ring-buffered SLIP network device for the border router
+ *
+ * Frame encoding follows RFC 1055, like RIOT's slipdev.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#ifdef GCOAP_CLI_SLIP_RB
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "irq.h"
+#include "net/gnrc/netif/raw.h"
+#include "net/netdev.h"
+#include "thread.h"
+#include "slip_rb.h"
+
+#define ENABLE_DEBUG (0)
+#include "debug.h"
+
+#define SLIP_END            (0xc0U)
+#define SLIP_ESC            (0xdbU)
+#define SLIP_END_ESC        (0xdcU)
+#define SLIP_ESC_ESC        (0xddU)
+
+/* Largest frame decoded for echo mode */
+#define SLIP_RB_ECHO_MAX    (1280U)
+
+static slip_rb_t _dev;
+static char _netif_stack[THREAD_STACKSIZE_DEFAULT];
+#ifdef GCOAP_CLI_SLIP_RB_ECHO
+static uint8_t _echo_buf[SLIP_RB_ECHO_MAX];
+#endif
+
+/*
+ * UART RX callback, in interrupt context. Does the minimum: queue the byte, and
+ * signal the netif thread at the end of a frame.
+ */
+static void _rx_cb(void *arg, uint8_t byte)
+{
+    slip_rb_t *dev = arg;
+
+    if (tsrb_add_one(&dev->rx_ring, byte) < 0) {
+        dev->stats.rx_overruns++;
+        return;
+    }
+    if (byte == SLIP_END) {
+        dev->rx_pending++;
+        if (dev->netdev.event_callback) {
+            dev->netdev.event_callback(&dev->netdev, NETDEV_EVENT_ISR);
+        }
+    }
+}
+
+/*
+ * Encodes bytes into chunk, and writes the chunk to the UART when full.
+ */
+static void _write(slip_rb_t *dev, uint8_t *chunk, size_t *pos,
+                   const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        /* leave room for an escape sequence */
+        if (*pos > SLIP_RB_TX_CHUNK - 2) {
+            uart_write(dev->uart, chunk, *pos);
+            dev->stats.tx_writes++;
+            *pos = 0;
+        }
+        switch (data[i]) {
+        case SLIP_END:
+            chunk[(*pos)++] = SLIP_ESC;
+            chunk[(*pos)++] = SLIP_END_ESC;
+            dev->stats.tx_escapes++;
+            break;
+        case SLIP_ESC:
+            chunk[(*pos)++] = SLIP_ESC;
+            chunk[(*pos)++] = SLIP_ESC_ESC;
+            dev->stats.tx_escapes++;
+            break;
+        default:
+            chunk[(*pos)++] = data[i];
+            break;
+        }
+    }
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    slip_rb_t *dev = (slip_rb_t *)netdev;
+    uint8_t chunk[SLIP_RB_TX_CHUNK];
+    size_t pos = 0;
+    int bytes = 0;
+
+    for (const iolist_t *iol = iolist; iol; iol = iol->iol_next) {
+        _write(dev, chunk, &pos, iol->iol_base, iol->iol_len);
+        bytes += iol->iol_len;
+    }
+    chunk[pos++] = SLIP_END;
+    uart_write(dev->uart, chunk, pos);
+
+    dev->stats.tx_writes++;
+    dev->stats.tx_frames++;
+    dev->stats.tx_bytes += bytes;
+    return bytes;
+}
+
+/*
+ * Decodes a frame from the ring into buf, or discards it if buf is NULL.
+ * Returns decoded length, or -ENOBUFS if buf too small.
+ */
+static int _decode(slip_rb_t *dev, uint8_t *buf, size_t len)
+{
+    size_t pos = 0;
+    bool escaped = false;
+    bool overflow = false;
+    int byte;
+
+    while ((byte = tsrb_get_one(&dev->rx_ring)) >= 0) {
+        if (byte == SLIP_END) {
+            unsigned state = irq_disable();
+            dev->rx_pending--;
+            irq_restore(state);
+            break;
+        }
+        if (escaped) {
+            escaped = false;
+            dev->stats.rx_escapes++;
+            if (byte == SLIP_END_ESC) {
+                byte = SLIP_END;
+            }
+            else if (byte == SLIP_ESC_ESC) {
+                byte = SLIP_ESC;
+            }
+        }
+        else if (byte == SLIP_ESC) {
+            escaped = true;
+            continue;
+        }
+
+        if (buf && pos < len) {
+            buf[pos] = byte;
+        }
+        else if (buf) {
+            overflow = true;
+        }
+        pos++;
+    }
+
+    if (!buf || overflow) {
+        dev->stats.rx_dropped++;
+        return overflow ? -ENOBUFS : (int)pos;
+    }
+    if (pos == 0) {
+        /* empty frame, from END used as a frame start marker */
+        return 0;
+    }
+    dev->stats.rx_frames++;
+    dev->stats.rx_bytes += pos;
+    return pos;
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    slip_rb_t *dev = (slip_rb_t *)netdev;
+    (void)info;
+
+    if (!dev->rx_pending) {
+        return 0;
+    }
+    if (buf == NULL) {
+        if (len > 0) {
+            /* drop frame */
+            return _decode(dev, NULL, 0);
+        }
+        /* upper bound on size of next frame */
+        return tsrb_avail(&dev->rx_ring);
+    }
+    return _decode(dev, buf, len);
+}
+
+static void _isr(netdev_t *netdev)
+{
+    slip_rb_t *dev = (slip_rb_t *)netdev;
+
+#ifdef GCOAP_CLI_SLIP_RB_ECHO
+    if (dev->echo) {
+        while (dev->rx_pending) {
+            int len = _decode(dev, _echo_buf, sizeof(_echo_buf));
+            if (len > 0) {
+                iolist_t iol = { .iol_base = _echo_buf, .iol_len = len };
+                _send(netdev, &iol);
+            }
+        }
+        return;
+    }
+#endif
+    while (dev->rx_pending) {
+        unsigned pending = dev->rx_pending;
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        if (dev->rx_pending == pending) {
+            /* stack did not read the frame; discard it so we don't spin */
+            _decode(dev, NULL, 0);
+        }
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    slip_rb_t *dev = (slip_rb_t *)netdev;
+
+    tsrb_init(&dev->rx_ring, (char *)dev->rx_mem, sizeof(dev->rx_mem));
+    if (uart_init(dev->uart, dev->baudrate, _rx_cb, dev) != UART_OK) {
+        DEBUG("slip_rb: error initializing UART %i\n", dev->uart);
+        return -ENODEV;
+    }
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    (void)netdev;
+    (void)max_len;
+
+    switch (opt) {
+    case NETOPT_IS_WIRED:
+        return 1;
+    case NETOPT_DEVICE_TYPE:
+        assert(max_len == sizeof(uint16_t));
+        *((uint16_t *)value) = NETDEV_TYPE_SLIP;
+        return sizeof(uint16_t);
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value, size_t len)
+{
+    (void)netdev;
+    (void)opt;
+    (void)value;
+    (void)len;
+    return -ENOTSUP;
+}
+
+static const netdev_driver_t _driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+void slip_rb_init(void)
+{
+    _dev.netdev.driver = &_driver;
+    _dev.uart = SLIP_UART;
+    _dev.baudrate = SLIP_BAUDRATE;
+
+    gnrc_netif_raw_create(_netif_stack, sizeof(_netif_stack),
+                          GNRC_NETIF_PRIO, "slip_rb", &_dev.netdev);
+}
+
+static void _print_overhead(const char *label, uint32_t escapes, uint32_t bytes)
+{
+    /* per mille, since escapes usually are rare */
+    unsigned permille = bytes ? ((uint64_t)escapes * 1000) / bytes : 0;
+    printf("%s escapes: %lu (%u.%u%% overhead)\n", label, (unsigned long)escapes,
+           permille / 10, permille % 10);
+}
+
+int slip_rb_cmd(int argc, char **argv)
+{
+    slip_rb_stats_t *stats = &_dev.stats;
+
+    if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+        unsigned state = irq_disable();
+        memset(stats, 0, sizeof(*stats));
+        irq_restore(state);
+        return 0;
+    }
+#ifdef GCOAP_CLI_SLIP_RB_ECHO
+    if (argc == 3 && strcmp(argv[1], "echo") == 0) {
+        _dev.echo = (strcmp(argv[2], "on") == 0);
+        return 0;
+    }
+#endif
+    if (argc != 1) {
+#ifdef GCOAP_CLI_SLIP_RB_ECHO
+        printf("usage: %s [reset|echo <on|off>]\n", argv[0]);
+#else
+        printf("usage: %s [reset]\n", argv[0]);
+#endif
+        return 1;
+    }
+
+    printf("SLIP on UART %i at %lu baud\n", SLIP_UART, (unsigned long)SLIP_BAUDRATE);
+    printf("RX frames: %lu, bytes: %lu, dropped: %lu, overruns: %lu\n",
+           (unsigned long)stats->rx_frames, (unsigned long)stats->rx_bytes,
+           (unsigned long)stats->rx_dropped, (unsigned long)stats->rx_overruns);
+    _print_overhead("RX", stats->rx_escapes, stats->rx_bytes);
+    printf("TX frames: %lu, bytes: %lu, UART writes: %lu\n",
+           (unsigned long)stats->tx_frames, (unsigned long)stats->tx_bytes,
+           (unsigned long)stats->tx_writes);
+    _print_overhead("TX", stats->tx_escapes, stats->tx_bytes);
+    return 0;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* GCOAP_CLI_SLIP_RB */
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     examples
+ * @{
+ *
+ * @file
+ * @brief       Ring-buffered SLIP network device for the border router
+ *
+ * Alternative to RIOT's slipdev driver, tuned for throughput. The UART ISR only
+ * pushes raw bytes into a lock-free single-producer/single-consumer ring buffer.
+ * Frames are decoded in the netif thread. Outgoing frames are encoded into a
+ * chunk buffer, and written to the UART a chunk at a time rather than a byte at a
+ * time.
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef SLIP_RB_H
+#define SLIP_RB_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "net/netdev.h"
+#include "periph/uart.h"
+#include "tsrb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief RX ring buffer size; must be a power of 2
+ */
+#ifndef SLIP_RB_RX_SIZE
+#define SLIP_RB_RX_SIZE     (2048U)
+#endif
+
+/**
+ * @brief TX chunk size, written to the UART in a single call
+ */
+#ifndef SLIP_RB_TX_CHUNK
+#define SLIP_RB_TX_CHUNK    (64U)
+#endif
+
+/**
+ * @brief Device statistics
+ */
+typedef struct {
+    uint32_t rx_frames;     /**< frames received */
+    uint32_t rx_bytes;      /**< decoded bytes received */
+    uint32_t rx_escapes;    /**< escape sequences received */
+    uint32_t rx_overruns;   /**< bytes dropped because RX ring was full */
+    uint32_t rx_dropped;    /**< frames dropped by the stack or too large */
+    uint32_t tx_frames;     /**< frames sent */
+    uint32_t tx_bytes;      /**< unencoded bytes sent */
+    uint32_t tx_escapes;    /**< escape sequences sent */
+    uint32_t tx_writes;     /**< UART write calls */
+} slip_rb_stats_t;
+
+/**
+ * @brief Device descriptor
+ */
+typedef struct {
+    netdev_t netdev;                    /**< parent class */
+    uart_t uart;                        /**< UART for the link */
+    uint32_t baudrate;                  /**< UART baudrate */
+    tsrb_t rx_ring;                     /**< RX ring buffer */
+    uint8_t rx_mem[SLIP_RB_RX_SIZE];    /**< memory for RX ring buffer */
+    volatile unsigned rx_pending;       /**< complete frames in rx_ring */
+    bool echo;                          /**< echo frames back; for benchmark */
+    slip_rb_stats_t stats;              /**< statistics */
+} slip_rb_t;
+
+/**
+ * @brief Creates the device and its GNRC network interface
+ *
+ * Uses SLIP_UART and SLIP_BAUDRATE for the link.
+ */
+void slip_rb_init(void);
+
+/**
+ * @brief Handler for the 'slip' shell command
+ */
+int slip_rb_cmd(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLIP_RB_H */
+/** @} */
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# Copyright (c) 2026 agent
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+SLIP link benchmark for the native build of gcoap-cli-plus.
+
+Starts the application with its SLIP UART on a pty, enables 'slip echo' mode,
+and then sends frames over the pty. Measures sustained frames per second and
+round trip latency for each baud rate requested.
+
+A pty does not enforce a baud rate, so this script paces its writes at the
+line rate for the requested baud, assuming 10 bits per byte. The return path is
+not paced, so latency includes only one line delay.
+
+Build the application with:
+
+    make -f Makefile.slip BOARD=native SLIP_RB=1 SLIP_RB_ECHO=1
+
+Then run, as root or with the tap interface already created:
+
+    ./tools/slip_bench.py bin/native/gcoap.elf
+'''
+
+import argparse
+import os
+import random
+import select
+import struct
+import subprocess
+import sys
+import time
+import tty
+
+SLIP_END = 0xc0
+SLIP_ESC = 0xdb
+SLIP_END_ESC = 0xdc
+SLIP_ESC_ESC = 0xdd
+
+DEFAULT_BAUDS = "9600,57600,115200,460800,921600"
+
+
+def slip_encode(data):
+    out = bytearray()
+    for byte in data:
+        if byte == SLIP_END:
+            out += bytes((SLIP_ESC, SLIP_END_ESC))
+        elif byte == SLIP_ESC:
+            out += bytes((SLIP_ESC, SLIP_ESC_ESC))
+        else:
+            out.append(byte)
+    out.append(SLIP_END)
+    return bytes(out)
+
+
+class SlipDecoder(object):
+    '''Incremental decoder; feed() returns the list of complete frames.'''
+
+    def __init__(self):
+        self.frame = bytearray()
+        self.escaped = False
+
+    def feed(self, data):
+        frames = []
+        for byte in data:
+            if byte == SLIP_END:
+                if self.frame:
+                    frames.append(bytes(self.frame))
+                self.frame = bytearray()
+            elif self.escaped:
+                self.escaped = False
+                self.frame.append(SLIP_END if byte == SLIP_END_ESC else SLIP_ESC)
+            elif byte == SLIP_ESC:
+                self.escaped = True
+            else:
+                self.frame.append(byte)
+        return frames
+
+
+def make_payload(seq, size, escape_ratio):
+    '''Sequence number, then random bytes with some END/ESC bytes to escape.'''
+    body = bytearray(random.getrandbits(8) & 0x7f for _ in range(size - 4))
+    for i in range(len(body)):
+        if random.random() < escape_ratio:
+            body[i] = random.choice((SLIP_END, SLIP_ESC))
+    return struct.pack("!I", seq) + bytes(body)
+
+
+def percentile(values, pct):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * pct / 100))]
+
+
+def run_baud(fd, baud, args):
+    '''Runs one benchmark pass. Returns a tuple of results for the table.'''
+    byte_time = 10.0 / baud
+    decoder = SlipDecoder()
+    sent = {}
+    latencies = []
+    next_seq = 0
+    next_send = time.monotonic()
+    start = next_send
+    deadline = None
+
+    while len(latencies) < args.frames:
+        now = time.monotonic()
+        if (next_seq < args.frames and len(sent) < args.window
+                and now >= next_send):
+            frame = slip_encode(make_payload(next_seq, args.size,
+                                             args.escape_ratio))
+            os.write(fd, frame)
+            sent[next_seq] = now
+            next_seq += 1
+            next_send = max(next_send, now) + len(frame) * byte_time
+            continue
+
+        if next_seq == args.frames and deadline is None:
+            deadline = now + args.timeout
+        if deadline is not None and now > deadline:
+            break
+
+        wait = max(0.0, next_send - now) if len(sent) < args.window else 0.1
+        ready, _, _ = select.select([fd], [], [], min(wait, 0.1))
+        if not ready:
+            continue
+        now = time.monotonic()
+        for frame in decoder.feed(os.read(fd, 4096)):
+            if len(frame) < 4:
+                continue
+            seq = struct.unpack("!I", frame[:4])[0]
+            if seq in sent:
+                latencies.append(now - sent.pop(seq))
+
+    elapsed = time.monotonic() - start
+    fps = len(latencies) / elapsed if elapsed else 0.0
+    return (baud, fps, percentile(latencies, 50) * 1000,
+            percentile(latencies, 99) * 1000, args.frames - len(latencies))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("elf", help="native gcoap.elf built with SLIP_RB_ECHO=1")
+    parser.add_argument("--tap", default="tap0", help="tap interface (default: tap0)")
+    parser.add_argument("--uart", type=int, default=1,
+                        help="SLIP_UART index (default: 1, the last native UART)")
+    parser.add_argument("-b", "--bauds", default=DEFAULT_BAUDS,
+                        help="comma separated baud rates (default: %s)" % DEFAULT_BAUDS)
+    parser.add_argument("-n", "--frames", type=int, default=500,
+                        help="frames per baud rate (default: 500)")
+    parser.add_argument("-s", "--size", type=int, default=80,
+                        help="frame payload size, at least 4 (default: 80)")
+    parser.add_argument("-w", "--window", type=int, default=4,
+                        help="max outstanding frames (default: 4)")
+    parser.add_argument("-e", "--escape-ratio", type=float, default=0.01,
+                        help="fraction of payload bytes that need escaping (default: 0.01)")
+    parser.add_argument("-t", "--timeout", type=float, default=2.0,
+                        help="seconds to wait for the last frames (default: 2)")
+    args = parser.parse_args()
+
+    if args.size < 4:
+        sys.exit("frame size must be at least 4")
+
+    # One pty per native UART; only the SLIP UART is used.
+    ptys = [os.openpty() for _ in range(args.uart + 1)]
+    for master, slave in ptys:
+        tty.setraw(master)
+        tty.setraw(slave)
+    cmd = [args.elf, args.tap]
+    for _, slave in ptys:
+        cmd += ["-c", os.ttyname(slave)]
+    fd = ptys[args.uart][0]
+
+    proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.DEVNULL,
+                            universal_newlines=True)
+    try:
+        time.sleep(1)
+        proc.stdin.write("slip echo on\n")
+        proc.stdin.flush()
+        time.sleep(0.2)
+
+        print("   baud    frames/s   p50 ms   p99 ms  lost")
+        for baud in (int(b) for b in args.bauds.split(",")):
+            result = run_baud(fd, baud, args)
+            print("%7d %11.1f %8.2f %8.2f %5d" % result)
+    finally:
+        proc.terminate()
+        proc.wait()
+
+
+if __name__ == "__main__":
+    main()
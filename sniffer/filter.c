@@ -0,0 +1,294 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     app_sniffer
+ * @{
+ *
+ * @file
+ * @brief       Capture filters for the sniffer
+ *
+ * Filters are evaluated in the raw dump thread, before a frame is copied for
+ * output. A frame is captured if it passes all enabled filters. For each
+ * filter, the count of frames it rejected is kept, to show how much output it
+ * saves.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "net/gnrc/netif.h"
+#include "net/ieee802154.h"
+
+#include "sniffer.h"
+
+/**
+ * @brief   Filters, in the order evaluated
+ */
+enum {
+    FILTER_LEN,                 /**< length range */
+    FILTER_LQI,                 /**< minimum LQI */
+    FILTER_TYPE,                /**< frame type */
+    FILTER_PAN,                 /**< source or destination PAN ID */
+    FILTER_SRC,                 /**< source address */
+    FILTER_DST,                 /**< destination address */
+    FILTER_NUMOF,
+};
+
+static const char *filter_names[] = { "len", "lqi", "type", "pan", "src", "dst" };
+
+static const char *type_names[] = { "beacon", "data", "ack", "cmd" };
+
+static struct {
+    bool on[FILTER_NUMOF];
+    uint16_t len_min;
+    uint16_t len_max;
+    uint8_t lqi_min;
+    uint8_t type;
+    uint16_t pan;
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t src_len;
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst_len;
+    size_t snaplen;
+} cfg;
+
+static struct {
+    uint32_t checked;
+    uint32_t passed;
+    uint32_t rejected[FILTER_NUMOF];
+} counts;
+
+#define TYPE_NUMOF  (sizeof(type_names) / sizeof(type_names[0]))
+
+/**
+ * @brief   Compare an address from a frame with a filter address
+ */
+static bool addr_equal(const uint8_t *addr, int len, const uint8_t *filter,
+                       uint8_t filter_len)
+{
+    return (len == filter_len) && (memcmp(addr, filter, len) == 0);
+}
+
+/**
+ * @brief   Evaluate the filters which need the MAC header
+ *
+ * @return  the rejecting filter, or FILTER_NUMOF if the frame passes
+ */
+static unsigned match_mhr(const uint8_t *mhr, size_t size)
+{
+    uint8_t src[IEEE802154_LONG_ADDRESS_LEN];
+    uint8_t dst[IEEE802154_LONG_ADDRESS_LEN];
+    le_uint16_t src_pan = { .u16 = 0 };
+    le_uint16_t dst_pan = { .u16 = 0 };
+    int src_len = -1;
+    int dst_len = -1;
+
+    size_t hdr_len = (size >= 3) ? ieee802154_get_frame_hdr_len(mhr) : 0;
+    if (hdr_len > 0 && hdr_len <= size) {
+        src_len = ieee802154_get_src(mhr, src, &src_pan);
+        dst_len = ieee802154_get_dst(mhr, dst, &dst_pan);
+    }
+
+    if (cfg.on[FILTER_TYPE] && (size < 1
+            || (mhr[0] & IEEE802154_FCF_TYPE_MASK) != cfg.type)) {
+        return FILTER_TYPE;
+    }
+    if (cfg.on[FILTER_PAN] && !((src_len > 0 && byteorder_ltohs(src_pan) == cfg.pan)
+                                || (dst_len > 0 && byteorder_ltohs(dst_pan) == cfg.pan))) {
+        return FILTER_PAN;
+    }
+    if (cfg.on[FILTER_SRC] && !addr_equal(src, src_len, cfg.src, cfg.src_len)) {
+        return FILTER_SRC;
+    }
+    if (cfg.on[FILTER_DST] && !addr_equal(dst, dst_len, cfg.dst, cfg.dst_len)) {
+        return FILTER_DST;
+    }
+    return FILTER_NUMOF;
+}
+
+bool filter_match(const uint8_t *mhr, size_t size, size_t len, uint8_t lqi)
+{
+    unsigned rejected = FILTER_NUMOF;
+
+    counts.checked++;
+    if (cfg.on[FILTER_LEN] && (len < cfg.len_min || len > cfg.len_max)) {
+        rejected = FILTER_LEN;
+    }
+    else if (cfg.on[FILTER_LQI] && lqi < cfg.lqi_min) {
+        rejected = FILTER_LQI;
+    }
+    else if (cfg.on[FILTER_TYPE] || cfg.on[FILTER_PAN]
+             || cfg.on[FILTER_SRC] || cfg.on[FILTER_DST]) {
+        rejected = match_mhr(mhr, size);
+    }
+
+    if (rejected < FILTER_NUMOF) {
+        counts.rejected[rejected]++;
+        return false;
+    }
+    counts.passed++;
+    return true;
+}
+
+size_t filter_snaplen(void)
+{
+    return cfg.snaplen;
+}
+
+static void print_filters(void)
+{
+    char addr_str[3 * IEEE802154_LONG_ADDRESS_LEN];
+
+    printf("frames: %lu checked, %lu passed\n", (unsigned long)counts.checked,
+           (unsigned long)counts.passed);
+    for (unsigned i = 0; i < FILTER_NUMOF; i++) {
+        printf("%-4s ", filter_names[i]);
+        if (!cfg.on[i]) {
+            printf("off ");
+        }
+        else {
+            switch (i) {
+                case FILTER_LEN:
+                    printf("%u-%u ", cfg.len_min, cfg.len_max);
+                    break;
+                case FILTER_LQI:
+                    printf(">= %u ", cfg.lqi_min);
+                    break;
+                case FILTER_TYPE:
+                    printf("%s ", type_names[cfg.type]);
+                    break;
+                case FILTER_PAN:
+                    printf("0x%04x ", cfg.pan);
+                    break;
+                case FILTER_SRC:
+                    printf("%s ", gnrc_netif_addr_to_str(cfg.src, cfg.src_len,
+                                                         addr_str));
+                    break;
+                case FILTER_DST:
+                    printf("%s ", gnrc_netif_addr_to_str(cfg.dst, cfg.dst_len,
+                                                         addr_str));
+                    break;
+            }
+        }
+        printf("rejected %lu\n", (unsigned long)counts.rejected[i]);
+    }
+    if (cfg.snaplen) {
+        printf("snaplen %u\n", (unsigned)cfg.snaplen);
+    }
+}
+
+/**
+ * @brief   Parse a filter setting
+ *
+ * @return  0 on success, -1 on a bad value
+ */
+static int set_filter(unsigned filter, int argc, char **argv)
+{
+    if (argc == 1 && strcmp(argv[0], "off") == 0) {
+        cfg.on[filter] = false;
+        return 0;
+    }
+
+    switch (filter) {
+        case FILTER_LEN:
+            if (argc != 2) {
+                return -1;
+            }
+            cfg.len_min = atoi(argv[0]);
+            cfg.len_max = atoi(argv[1]);
+            break;
+        case FILTER_LQI:
+            if (argc != 1) {
+                return -1;
+            }
+            cfg.lqi_min = atoi(argv[0]);
+            break;
+        case FILTER_TYPE: {
+            unsigned type;
+            for (type = 0; type < TYPE_NUMOF; type++) {
+                if (argc == 1 && strcmp(argv[0], type_names[type]) == 0) {
+                    break;
+                }
+            }
+            if (type == TYPE_NUMOF) {
+                return -1;
+            }
+            cfg.type = type;
+            break;
+        }
+        case FILTER_PAN:
+            if (argc != 1) {
+                return -1;
+            }
+            cfg.pan = strtoul(argv[0], NULL, 16);
+            break;
+        case FILTER_SRC:
+        case FILTER_DST: {
+            uint8_t *addr = (filter == FILTER_SRC) ? cfg.src : cfg.dst;
+            uint8_t *addr_len = (filter == FILTER_SRC) ? &cfg.src_len : &cfg.dst_len;
+            uint8_t tmp[GNRC_NETIF_L2ADDR_MAXLEN];
+            size_t len = (argc == 1) ? gnrc_netif_addr_from_str(argv[0], tmp) : 0;
+            if (len != IEEE802154_SHORT_ADDRESS_LEN
+                    && len != IEEE802154_LONG_ADDRESS_LEN) {
+                return -1;
+            }
+            memcpy(addr, tmp, len);
+            *addr_len = len;
+            break;
+        }
+    }
+    cfg.on[filter] = true;
+    return 0;
+}
+
+int filter_cmd(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "snaplen") == 0) {
+        cfg.snaplen = atoi(argv[2]);
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "filter") == 0) {
+        print_filters();
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "filter") == 0
+            && strcmp(argv[2], "reset") == 0) {
+        memset(&counts, 0, sizeof(counts));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "filter") == 0
+            && strcmp(argv[2], "clear") == 0) {
+        memset(cfg.on, 0, sizeof(cfg.on));
+        return 0;
+    }
+    if (argc > 3 && strcmp(argv[1], "filter") == 0) {
+        for (unsigned i = 0; i < FILTER_NUMOF; i++) {
+            if (strcmp(argv[2], filter_names[i]) == 0) {
+                if (set_filter(i, argc - 3, &argv[3]) < 0) {
+                    break;
+                }
+                return 0;
+            }
+        }
+    }
+
+    printf("usage: %s filter [clear|reset]\n", argv[0]);
+    printf("       %s filter len <min> <max>|off\n", argv[0]);
+    printf("       %s filter lqi <min>|off\n", argv[0]);
+    printf("       %s filter type beacon|data|ack|cmd|off\n", argv[0]);
+    printf("       %s filter pan <hex id>|off\n", argv[0]);
+    printf("       %s filter src|dst <addr>|off\n", argv[0]);
+    printf("       %s snaplen <bytes>, 0 for no limit\n", argv[0]);
+    return 1;
+}
@@ -14,6 +14,12 @@
  * @file
  * @brief       Sniffer application for RIOT
  *
+ * Received frames are copied into a byte ring buffer by the raw dump thread,
+ * which releases each packet right away. A writer thread of lower priority
+ * formats the frames from the ring, and writes the output in large chunks. So
+ * slow output does not hold packets in the packet buffer, and a frame that
+ * does not fit in the ring is counted as dropped.
+ *
  * @author      Hauke Petersen <hauke.petersen@fu-berlin.de>
  * @author      Martine Lenders <m.lenders@fu-berlin.de>
  *
@@ -21,13 +27,19 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "fmt.h"
+#include "irq.h"
 #include "thread.h"
+#include "tsrb.h"
 #include "xtimer.h"
 #include "shell.h"
 #include "shell_commands.h"
 #include "net/gnrc.h"
+#include "net/gnrc/netif/hdr.h"
+
+#include "sniffer.h"
 
 /**
  * @brief   Buffer size used by the shell
@@ -37,51 +49,352 @@
 /**
  * @brief   Priority of the RAW dump thread
  */
-#define RAWDUMP_PRIO            (THREAD_PRIORITY_MAIN - 1)
+#define RAWDUMP_PRIO            (THREAD_PRIORITY_MAIN - 2)
 
 /**
  * @brief   Message queue size of the RAW dump thread
  */
 #define RAWDUMP_MSG_Q_SIZE      (32U)
 
+/**
+ * @brief   Priority of the writer thread; lower than the RAW dump thread
+ */
+#define WRITER_PRIO             (THREAD_PRIORITY_MAIN - 1)
+
+/**
+ * @brief   Message type to wake the writer thread
+ */
+#define WRITER_MSG_TYPE         (0x5301)
+
+/**
+ * @brief   Size of the ring buffer for received frames; must be a power of 2
+ */
+#ifndef SNIFFER_RING_SIZE
+#define SNIFFER_RING_SIZE       (4096U)
+#endif
+
+/**
+ * @brief   Size of the output chunk, written at once by the writer thread
+ */
+#ifndef SNIFFER_OUT_CHUNK
+#define SNIFFER_OUT_CHUNK       (256U)
+#endif
+
+/**
+ * @brief   Interval to refresh the cached channel of a network interface
+ */
+#define CHAN_REFRESH_US         (1U * US_PER_SEC)
+
+/**
+ * @brief   Binary frame header: magic, version, then fields as below
+ */
+#define BIN_MAGIC               (0x52U)
+#define BIN_VERSION             (1U)
+#define BIN_HDR_LEN             (16U)
+
+/**
+ * @brief   SLIP special characters, RFC 1055
+ */
+#define SLIP_END                (0xc0U)
+#define SLIP_ESC                (0xdbU)
+#define SLIP_END_ESC            (0xdcU)
+#define SLIP_ESC_ESC            (0xddU)
+
+/**
+ * @brief   Output formats
+ */
+typedef enum {
+    OUT_TEXT,                   /**< hex text, one line per frame */
+    OUT_SLIP,                   /**< binary header and frame, SLIP framed */
+    OUT_ZEP,                    /**< ZEP over UDP */
+} out_fmt_t;
+
+/**
+ * @brief   Binary header flag for a frame truncated to the snap length
+ */
+#define BIN_FLAG_TRUNCATED      (0x01U)
+
+/**
+ * @brief   Capture statistics
+ */
+typedef struct {
+    uint32_t frames;            /**< frames received */
+    uint32_t dropped;           /**< frames dropped, since the ring was full */
+    uint32_t ring_hwm;          /**< max bytes used in the ring */
+    uint32_t queue_hwm;         /**< max messages waiting for RAW dump */
+    uint32_t out_bytes;         /**< bytes written */
+    uint32_t out_writes;        /**< writes of an output chunk */
+} stats_t;
+
 /**
  * @brief   Stack for the raw dump thread
  */
 static char rawdmp_stack[THREAD_STACKSIZE_SMALL];
 
 /**
- * @brief   Make a raw dump of the given packet contents
+ * @brief   Stack for the writer thread
+ */
+static char writer_stack[THREAD_STACKSIZE_DEFAULT];
+
+/**
+ * @brief   PID of the writer thread
+ */
+static kernel_pid_t writer_pid = KERNEL_PID_UNDEF;
+
+/**
+ * @brief   Current output format
+ */
+static out_fmt_t out_fmt = OUT_TEXT;
+
+/**
+ * @brief   Ring buffer for received frames, from RAW dump to writer thread
+ */
+static char ring_mem[SNIFFER_RING_SIZE];
+static tsrb_t ring = TSRB_INIT(ring_mem);
+
+/**
+ * @brief   Output chunk; used only by the writer thread
+ */
+static char out_buf[SNIFFER_OUT_CHUNK];
+static size_t out_pos;
+
+static stats_t stats;
+
+/**
+ * @brief   Get the channel of a network interface
+ *
+ * Uses the channel set by the scheduler, if any. Otherwise the channel is
+ * cached, since asking the interface blocks on its thread.
+ */
+static uint8_t get_chan(kernel_pid_t pid)
+{
+    static kernel_pid_t last_pid = KERNEL_PID_UNDEF;
+    static uint32_t last_time;
+    static uint16_t chan;
+    uint32_t now = xtimer_now_usec();
+    int sched = sched_chan(pid);
+
+    if (sched >= 0) {
+        return sched;
+    }
+
+    if (pid != last_pid || (now - last_time) > CHAN_REFRESH_US) {
+        if (gnrc_netapi_get(pid, NETOPT_CHANNEL, 0, &chan, sizeof(chan)) < 0) {
+            chan = 0;
+        }
+        last_pid = pid;
+        last_time = now;
+    }
+    return (uint8_t)chan;
+}
+
+/**
+ * @brief   Write the output chunk
+ */
+static void out_flush(void)
+{
+    if (out_pos) {
+        print(out_buf, out_pos);
+        stats.out_bytes += out_pos;
+        stats.out_writes++;
+        out_pos = 0;
+    }
+}
+
+/**
+ * @brief   Add data to the output chunk, and write the chunk when full
+ */
+static void out_put(const char *data, size_t len)
+{
+    while (len) {
+        size_t part = sizeof(out_buf) - out_pos;
+        if (part > len) {
+            part = len;
+        }
+        memcpy(&out_buf[out_pos], data, part);
+        out_pos += part;
+        data += part;
+        len -= part;
+        if (out_pos == sizeof(out_buf)) {
+            out_flush();
+        }
+    }
+}
+
+/**
+ * @brief   Add a SLIP encoded byte to the output chunk
+ */
+static void out_put_slip(uint8_t byte)
+{
+    char esc[2] = { SLIP_ESC };
+
+    if (byte == SLIP_END) {
+        esc[1] = SLIP_END_ESC;
+        out_put(esc, 2);
+    }
+    else if (byte == SLIP_ESC) {
+        esc[1] = SLIP_ESC_ESC;
+        out_put(esc, 2);
+    }
+    else {
+        out_put((char *)&byte, 1);
+    }
+}
+
+/**
+ * @brief   Format a frame from the ring as hex text
+ */
+static void write_text(const rx_info_t *info)
+{
+    char num[16];
+
+    out_put("rftest-rx --- len ", 18);
+    out_put(num, fmt_u32_hex(num, info->len));
+    out_put(" lqi ", 5);
+    out_put(num, fmt_byte_hex(num, info->lqi));
+    out_put(" rx_time ", 9);
+    out_put(num, fmt_u64_hex(num, info->rx_time));
+    out_put(" chan ", 6);
+    out_put(num, fmt_byte_hex(num, info->chan));
+    out_put("\n", 1);
+    for (unsigned i = 0; i < info->len; i++) {
+        num[fmt_byte_hex(num, (uint8_t)tsrb_get_one(&ring))] = ' ';
+        out_put(num, 3);
+    }
+    out_put("\n\n", 2);
+}
+
+/**
+ * @brief   Format a frame from the ring in binary format, as a SLIP frame
+ *
+ * The header is little endian: magic, version, length (2 bytes), LQI, RSSI,
+ * channel, flags, and the rx time in usec (8 bytes).
+ */
+static void write_slip(const rx_info_t *info)
+{
+    uint8_t hdr[BIN_HDR_LEN];
+    char end = SLIP_END;
+
+    hdr[0] = BIN_MAGIC;
+    hdr[1] = BIN_VERSION;
+    hdr[2] = info->len & 0xff;
+    hdr[3] = info->len >> 8;
+    hdr[4] = info->lqi;
+    hdr[5] = (uint8_t)info->rssi;
+    hdr[6] = info->chan;
+    hdr[7] = info->flags;
+    for (unsigned i = 0; i < 8; i++) {
+        hdr[8 + i] = (info->rx_time >> (8 * i)) & 0xff;
+    }
+
+    /* leading END flushes any line noise at the receiver */
+    out_put(&end, 1);
+    for (unsigned i = 0; i < sizeof(hdr); i++) {
+        out_put_slip(hdr[i]);
+    }
+    for (unsigned i = 0; i < info->len; i++) {
+        out_put_slip((uint8_t)tsrb_get_one(&ring));
+    }
+    out_put(&end, 1);
+}
+
+/**
+ * @brief   Copy the given packet into the ring, and release it
  */
 void dump_pkt(gnrc_pktsnip_t *pkt)
 {
-    gnrc_pktsnip_t *snip = pkt;
-    uint8_t lqi = 0;
+    rx_info_t info = { 0 };
+
     if (pkt->next) {
         if (pkt->next->type == GNRC_NETTYPE_NETIF) {
             gnrc_netif_hdr_t *netif_hdr = pkt->next->data;
-            lqi = netif_hdr->lqi;
+            info.lqi = netif_hdr->lqi;
+            info.rssi = (int8_t)netif_hdr->rssi;
+            info.netif = netif_hdr->if_pid;
+            info.chan = get_chan(netif_hdr->if_pid);
             pkt = gnrc_pktbuf_remove_snip(pkt, pkt->next);
         }
     }
-    uint64_t now_us = xtimer_usec_from_ticks64(xtimer_now64());
-
-    print_str("rftest-rx --- len ");
-    print_u32_hex((uint32_t)gnrc_pkt_len(pkt));
-    print_str(" lqi ");
-    print_byte_hex(lqi);
-    print_str(" rx_time ");
-    print_u64_hex(now_us);
-    print_str("\n");
-    while (snip) {
-        for (size_t i = 0; i < snip->size; i++) {
-            print_byte_hex(((uint8_t *)(snip->data))[i]);
-            print_str(" ");
-        }
-        snip = snip->next;
+    info.rx_time = xtimer_usec_from_ticks64(xtimer_now64());
+    size_t len = gnrc_pkt_len(pkt);
+    stats.frames++;
+    sched_count(info.chan);
+
+    if (!filter_match(pkt->data, pkt->size, len, info.lqi)) {
+        gnrc_pktbuf_release(pkt);
+        return;
     }
-    print_str("\n\n");
+    size_t snaplen = filter_snaplen();
+    if (snaplen && len > snaplen) {
+        len = snaplen;
+        info.flags |= BIN_FLAG_TRUNCATED;
+    }
+    info.len = len;
 
+    if (SNIFFER_RING_SIZE - tsrb_avail(&ring) < sizeof(info) + len) {
+        stats.dropped++;
+        gnrc_pktbuf_release(pkt);
+        return;
+    }
+    tsrb_add(&ring, (char *)&info, sizeof(info));
+    for (gnrc_pktsnip_t *snip = pkt; snip && len; snip = snip->next) {
+        size_t part = (snip->size < len) ? snip->size : len;
+        tsrb_add(&ring, snip->data, part);
+        len -= part;
+    }
     gnrc_pktbuf_release(pkt);
+
+    unsigned used = tsrb_avail(&ring);
+    if (used > stats.ring_hwm) {
+        stats.ring_hwm = used;
+    }
+
+    msg_t msg = { .type = WRITER_MSG_TYPE };
+    /* fails only if the writer already has a wake up pending */
+    msg_try_send(&msg, writer_pid);
+}
+
+/**
+ * @brief   Event loop of the writer thread; drains the ring to stdio
+ *
+ * @param[in] arg   unused parameter
+ */
+void *writer(void *arg)
+{
+    msg_t msg_q[1];
+
+    (void)arg;
+    msg_init_queue(msg_q, 1);
+    while (1) {
+        msg_t msg;
+
+        msg_receive(&msg);
+        while (!tsrb_empty(&ring)) {
+            rx_info_t info;
+
+            tsrb_get(&ring, (char *)&info, sizeof(info));
+            switch (out_fmt) {
+                case OUT_SLIP:
+                    write_slip(&info);
+                    break;
+#ifdef SNIFFER_ZEP
+                case OUT_ZEP:
+                    zep_write(&info, &ring);
+                    break;
+#endif
+                default:
+                    write_text(&info);
+                    break;
+            }
+        }
+        out_flush();
+#ifdef SNIFFER_ZEP
+        zep_flush();
+#endif
+    }
+
+    /* never reached */
+    return NULL;
 }
 
 /**
@@ -99,6 +412,11 @@ void *rawdump(void *arg)
         msg_t msg;
 
         msg_receive(&msg);
+        /* count this message too */
+        unsigned waiting = msg_avail() + 1;
+        if (waiting > stats.queue_hwm) {
+            stats.queue_hwm = waiting;
+        }
         switch (msg.type) {
             case GNRC_NETAPI_MSG_TYPE_RCV:
                 dump_pkt((gnrc_pktsnip_t *)msg.content.ptr);
@@ -113,6 +431,92 @@ void *rawdump(void *arg)
     return NULL;
 }
 
+/**
+ * @brief   Print the capture statistics
+ */
+static void print_stats(void)
+{
+    printf("frames: %lu, dropped: %lu\n", (unsigned long)stats.frames,
+           (unsigned long)stats.dropped);
+    printf("ring: %u of %u bytes used, high-water %lu\n",
+           tsrb_avail(&ring), SNIFFER_RING_SIZE, (unsigned long)stats.ring_hwm);
+    printf("queue: high-water %lu of %u msgs\n",
+           (unsigned long)stats.queue_hwm, RAWDUMP_MSG_Q_SIZE);
+    printf("output: %lu bytes in %lu writes\n",
+           (unsigned long)stats.out_bytes, (unsigned long)stats.out_writes);
+#ifdef SNIFFER_ZEP
+    zep_stats();
+#endif
+}
+
+/**
+ * @brief   Shell command to configure the sniffer
+ */
+static int sniffer_cmd(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "out") == 0) {
+        if (strcmp(argv[2], "text") == 0) {
+            out_fmt = OUT_TEXT;
+            return 0;
+        }
+        if (strcmp(argv[2], "slip") == 0) {
+            out_fmt = OUT_SLIP;
+            return 0;
+        }
+    }
+#ifdef SNIFFER_ZEP
+    if (argc > 3 && strcmp(argv[1], "out") == 0 && strcmp(argv[2], "zep") == 0) {
+        /* keep the current format on failure; zep.c locks out the writer
+         * while the socket is replaced */
+        if (zep_config(argc - 3, &argv[3]) < 0) {
+            return 1;
+        }
+        out_fmt = OUT_ZEP;
+        return 0;
+    }
+#endif
+    if (argc > 1 && (strcmp(argv[1], "filter") == 0
+                     || strcmp(argv[1], "snaplen") == 0)) {
+        return filter_cmd(argc, argv);
+    }
+    if (argc > 1 && (strcmp(argv[1], "hop") == 0
+                     || strcmp(argv[1], "pin") == 0
+                     || strcmp(argv[1], "chans") == 0)) {
+        return sched_cmd(argc, argv);
+    }
+    if (argc == 2 && strcmp(argv[1], "stats") == 0) {
+        print_stats();
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "stats") == 0
+            && strcmp(argv[2], "reset") == 0) {
+        unsigned state = irq_disable();
+        memset(&stats, 0, sizeof(stats));
+        irq_restore(state);
+        return 0;
+    }
+    printf("usage: %s out <text|slip>\n", argv[0]);
+#ifdef SNIFFER_ZEP
+    printf("       %s out zep <addr>[%%iface] [port] [batch]\n", argv[0]);
+#endif
+    printf("       %s stats [reset]\n", argv[0]);
+    printf("       %s filter ..., see '%s filter help'\n", argv[0], argv[0]);
+    printf("       %s snaplen <bytes>\n", argv[0]);
+    printf("       %s hop|pin|chans ..., see '%s hop help'\n", argv[0], argv[0]);
+    return 1;
+}
+
+/**
+ * @brief   Shell commands of the sniffer
+ */
+static const shell_command_t shell_commands[] = {
+    { "sniffer", "configure the sniffer", sniffer_cmd },
+#ifdef SNIFFER_REPLAY
+    { "replay", "replay frames for a benchmark", replay_cmd },
+#endif
+    { NULL, NULL, NULL }
+};
+
 /**
  * @brief   Maybe you are a golfer?!
  */
@@ -122,7 +526,13 @@ int main(void)
 
     puts("RIOT sniffer application");
 
-    /* start and register rawdump thread */
+    /* start the scheduler and writer, then the rawdump thread and register it */
+    sched_init();
+#ifdef SNIFFER_REPLAY
+    replay_init();
+#endif
+    writer_pid = thread_create(writer_stack, sizeof(writer_stack), WRITER_PRIO,
+                               THREAD_CREATE_STACKTEST, writer, NULL, "writer");
     puts("Run the rawdump thread and register it");
     dump.target.pid = thread_create(rawdmp_stack, sizeof(rawdmp_stack), RAWDUMP_PRIO,
                                     THREAD_CREATE_STACKTEST, rawdump, NULL, "rawdump");
@@ -132,7 +542,7 @@ int main(void)
     /* start the shell */
     puts("All ok, starting the shell now");
     char line_buf[SHELL_DEFAULT_BUFSIZE];
-    shell_run(NULL, line_buf, SHELL_DEFAULT_BUFSIZE);
+    shell_run(shell_commands, line_buf, SHELL_DEFAULT_BUFSIZE);
 
     return 0;
 }
@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     app_sniffer
+ * @{
+ *
+ * @file
+ * @brief       Replay network device, to benchmark the sniffer on native
+ *
+ * A network device that receives IEEE 802.15.4 frames from a pcap file, or
+ * synthetic data frames, at a set rate. It runs on a GNRC IEEE 802.15.4
+ * interface in raw mode, so frames pass through the interface thread to the
+ * sniffer, with a netif header for LQI and RSSI, like frames from a radio. A
+ * frame the stack can not take, for lack of packet buffer, is counted as
+ * dropped.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#ifdef SNIFFER_REPLAY
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "native_internal.h"
+#include "net/gnrc/netapi.h"
+#include "net/gnrc/netif/ieee802154.h"
+#include "net/netdev.h"
+#include "net/netdev/ieee802154.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "sniffer.h"
+
+/**
+ * @brief   Size of the buffer for frames from a pcap file
+ */
+#ifndef SNIFFER_REPLAY_BUF_SIZE
+#define SNIFFER_REPLAY_BUF_SIZE     (64U * 1024)
+#endif
+
+/**
+ * @brief   Max frames from a pcap file
+ */
+#ifndef SNIFFER_REPLAY_FRAMES_MAX
+#define SNIFFER_REPLAY_FRAMES_MAX   (1024U)
+#endif
+
+/**
+ * @brief   Frames waiting for the interface thread; must be a power of 2
+ */
+#define QUEUE_SIZE          (64U)
+
+#define TICK_US             (1000U)
+/* the queue is refilled once per tick, so this is the highest rate */
+#define RATE_MAX            (QUEUE_SIZE * (US_PER_SEC / TICK_US))
+#define REPLAY_PRIO         (THREAD_PRIORITY_MAIN - 4)
+#define REPLAY_CHAN         (26U)
+#define REPLAY_LQI          (0xffU)
+#define REPLAY_RSSI         (-40)
+#define SYNTH_LEN_DEFAULT   (40U)
+#define FRAME_MAX           (127U)
+
+#define PCAP_MAGIC          (0xa1b2c3d4UL)
+#define PCAP_HDR_LEN        (24U)
+#define PCAP_REC_HDR_LEN    (16U)
+#define LINKTYPE_FCS        (195U)      /* 802.15.4 with FCS */
+#define LINKTYPE_NOFCS      (230U)      /* 802.15.4 without FCS */
+
+typedef struct {
+    uint16_t offset;
+    uint8_t len;
+} frame_t;
+
+static netdev_ieee802154_t dev;
+static char netif_stack[THREAD_STACKSIZE_DEFAULT];
+static char replay_stack[THREAD_STACKSIZE_DEFAULT];
+static kernel_pid_t replay_pid = KERNEL_PID_UNDEF;
+
+/* frames from a pcap file; none for synthetic frames */
+static uint8_t file_buf[SNIFFER_REPLAY_BUF_SIZE];
+static frame_t frames[SNIFFER_REPLAY_FRAMES_MAX];
+static unsigned frame_count;
+
+static uint8_t synth[FRAME_MAX];
+static uint8_t synth_len = SYNTH_LEN_DEFAULT;
+
+/* queue of frame indices, from replay thread to interface thread */
+static unsigned queue[QUEUE_SIZE];
+static volatile unsigned queue_head;
+static volatile unsigned queue_tail;
+
+static struct {
+    volatile bool running;
+    uint32_t rate;              /* frames per second */
+    uint32_t count;             /* frames to send; 0 for no limit */
+} cfg;
+
+static struct {
+    uint32_t sent;              /* frames queued for the interface */
+    uint32_t overruns;          /* frames not queued, since queue was full */
+    uint32_t received;          /* frames read by the stack */
+    uint32_t dropped;           /* frames dropped by the stack */
+    uint32_t start;             /* start time */
+    uint32_t elapsed;           /* duration of the last run */
+} stats;
+
+/**
+ * @brief   Get a frame to replay
+ */
+static const uint8_t *get_frame(unsigned idx, size_t *len)
+{
+    if (frame_count) {
+        frame_t *frame = &frames[idx % frame_count];
+        *len = frame->len;
+        return &file_buf[frame->offset];
+    }
+    /* synthetic data frame; idx as the sequence number */
+    synth[2] = idx & 0xff;
+    *len = synth_len;
+    return synth;
+}
+
+static int _send(netdev_t *netdev, const iolist_t *iolist)
+{
+    (void)netdev;
+    return iolist_size(iolist);
+}
+
+static int _recv(netdev_t *netdev, void *buf, size_t len, void *info)
+{
+    (void)netdev;
+
+    if (queue_head == queue_tail) {
+        return 0;
+    }
+    size_t frame_len;
+    const uint8_t *frame = get_frame(queue[queue_tail % QUEUE_SIZE], &frame_len);
+    if (buf == NULL) {
+        if (len > 0) {
+            /* stack drops the frame */
+            queue_tail++;
+            stats.dropped++;
+        }
+        return frame_len;
+    }
+    if (len < frame_len) {
+        queue_tail++;
+        stats.dropped++;
+        return -ENOBUFS;
+    }
+    memcpy(buf, frame, frame_len);
+    if (info != NULL) {
+        netdev_ieee802154_rx_info_t *rx_info = info;
+        rx_info->lqi = REPLAY_LQI;
+        rx_info->rssi = (uint8_t)REPLAY_RSSI;
+    }
+    queue_tail++;
+    stats.received++;
+    return frame_len;
+}
+
+static void _isr(netdev_t *netdev)
+{
+    while (queue_head != queue_tail) {
+        unsigned tail = queue_tail;
+        netdev->event_callback(netdev, NETDEV_EVENT_RX_COMPLETE);
+        if (queue_tail == tail) {
+            /* stack did not read the frame; discard it so we don't spin */
+            queue_tail++;
+            stats.dropped++;
+        }
+    }
+}
+
+static int _init(netdev_t *netdev)
+{
+    (void)netdev;
+    return 0;
+}
+
+static int _get(netdev_t *netdev, netopt_t opt, void *value, size_t max_len)
+{
+    /* the channel and addresses are kept by netdev_ieee802154 */
+    return netdev_ieee802154_get((netdev_ieee802154_t *)netdev, opt, value,
+                                 max_len);
+}
+
+static int _set(netdev_t *netdev, netopt_t opt, const void *value, size_t len)
+{
+    return netdev_ieee802154_set((netdev_ieee802154_t *)netdev, opt, value,
+                                 len);
+}
+
+static const netdev_driver_t driver = {
+    .send = _send,
+    .recv = _recv,
+    .init = _init,
+    .isr = _isr,
+    .get = _get,
+    .set = _set,
+};
+
+static void *replay_thread(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        if (!cfg.running) {
+            thread_sleep();
+            continue;
+        }
+
+        xtimer_ticks32_t last_wakeup = xtimer_now();
+        uint32_t sent = 0;
+        stats.start = xtimer_now_usec();
+        while (cfg.running && (cfg.count == 0 || sent < cfg.count)) {
+            xtimer_periodic_wakeup(&last_wakeup, TICK_US);
+            uint64_t elapsed = xtimer_now_usec() - stats.start;
+            uint32_t due = (elapsed * cfg.rate) / US_PER_SEC;
+            if (cfg.count && due > cfg.count) {
+                due = cfg.count;
+            }
+            bool queued = false;
+            for (; sent < due; sent++) {
+                if (queue_head - queue_tail >= QUEUE_SIZE) {
+                    stats.overruns++;
+                    continue;
+                }
+                queue[queue_head % QUEUE_SIZE] = sent;
+                queue_head++;
+                stats.sent++;
+                queued = true;
+            }
+            if (queued) {
+                dev.netdev.event_callback(&dev.netdev, NETDEV_EVENT_ISR);
+            }
+        }
+        stats.elapsed = xtimer_now_usec() - stats.start;
+        cfg.running = false;
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+/**
+ * @brief   Load frames from a pcap file, for 802.15.4 with or without FCS
+ *
+ * @return  count of frames loaded, or -1 on error
+ */
+static int load_pcap(const char *path)
+{
+    uint8_t hdr[PCAP_HDR_LEN];
+    size_t pos = 0;
+    int res = -1;
+
+    _native_syscall_enter();
+    FILE *file = real_fopen(path, "rb");
+    if (file == NULL) {
+        goto out;
+    }
+    if (real_fread(hdr, 1, sizeof(hdr), file) != sizeof(hdr)) {
+        goto close;
+    }
+    uint32_t magic = hdr[0] | (hdr[1] << 8) | (hdr[2] << 16) | ((uint32_t)hdr[3] << 24);
+    uint32_t linktype = hdr[20] | (hdr[21] << 8);
+    if (magic != PCAP_MAGIC
+            || (linktype != LINKTYPE_FCS && linktype != LINKTYPE_NOFCS)) {
+        goto close;
+    }
+
+    frame_count = 0;
+    while (frame_count < SNIFFER_REPLAY_FRAMES_MAX) {
+        uint8_t rec[PCAP_REC_HDR_LEN];
+        if (real_fread(rec, 1, sizeof(rec), file) != sizeof(rec)) {
+            break;
+        }
+        uint32_t caplen = rec[8] | (rec[9] << 8) | (rec[10] << 16)
+                          | ((uint32_t)rec[11] << 24);
+        if (caplen > FRAME_MAX || pos + caplen > sizeof(file_buf)
+                || real_fread(&file_buf[pos], 1, caplen, file) != caplen) {
+            break;
+        }
+        if (linktype == LINKTYPE_FCS && caplen >= 2) {
+            caplen -= 2;
+        }
+        frames[frame_count].offset = pos;
+        frames[frame_count].len = caplen;
+        frame_count++;
+        pos += caplen;
+    }
+    res = frame_count;
+
+close:
+    real_fclose(file);
+out:
+    _native_syscall_leave();
+    return res;
+}
+
+static void print_stats(void)
+{
+    printf("replay: %lu sent, %lu overruns, %lu received, %lu dropped by stack\n",
+           (unsigned long)stats.sent, (unsigned long)stats.overruns,
+           (unsigned long)stats.received, (unsigned long)stats.dropped);
+    uint32_t elapsed = cfg.running ? xtimer_now_usec() - stats.start
+                                   : stats.elapsed;
+    if (elapsed) {
+        printf("replay: %lu ms, %lu frames/s\n",
+               (unsigned long)(elapsed / US_PER_MS),
+               (unsigned long)(((uint64_t)stats.received * US_PER_SEC) / elapsed));
+    }
+    printf("replay: %s, %u frames from %s\n", cfg.running ? "running" : "idle",
+           frame_count ? frame_count : 1, frame_count ? "file" : "generator");
+}
+
+void replay_init(void)
+{
+    /* data frame, PAN ID compression, short addresses */
+    static const uint8_t mhr[] = { 0x41, 0x88, 0x00, 0x23, 0x00, 0xff, 0xff,
+                                   0x01, 0x00 };
+
+    memcpy(synth, mhr, sizeof(mhr));
+    for (unsigned i = sizeof(mhr); i < sizeof(synth); i++) {
+        synth[i] = i;
+    }
+
+    dev.netdev.driver = &driver;
+    dev.chan = REPLAY_CHAN;
+    gnrc_netif_t *netif = gnrc_netif_ieee802154_create(netif_stack,
+                                                       sizeof(netif_stack),
+                                                       GNRC_NETIF_PRIO,
+                                                       "replay",
+                                                       &dev.netdev);
+    /* raw mode passes the whole frame up, with a netif header */
+    netopt_enable_t raw = NETOPT_ENABLE;
+    if (netif == NULL || gnrc_netapi_set(netif->pid, NETOPT_RAW, 0, &raw,
+                                         sizeof(raw)) < 0) {
+        puts("replay: unable to set raw mode");
+    }
+    replay_pid = thread_create(replay_stack, sizeof(replay_stack), REPLAY_PRIO,
+                               THREAD_CREATE_STACKTEST, replay_thread, NULL,
+                               "replay");
+}
+
+int replay_cmd(int argc, char **argv)
+{
+    if (argc == 3 && cfg.running
+            && (strcmp(argv[1], "file") == 0 || strcmp(argv[1], "synth") == 0)) {
+        /* the interface thread reads the frames while running */
+        puts("replay: running; stop it first");
+        return 1;
+    }
+    if (argc == 3 && strcmp(argv[1], "file") == 0) {
+        int res = load_pcap(argv[2]);
+        if (res < 0) {
+            printf("replay: can't read 802.15.4 pcap from %s\n", argv[2]);
+            return 1;
+        }
+        printf("replay: %d frames\n", res);
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "synth") == 0) {
+        unsigned len = atoi(argv[2]);
+        if (len < 9 || len > FRAME_MAX) {
+            puts("replay: length must be 9 to 127");
+            return 1;
+        }
+        synth_len = len;
+        frame_count = 0;
+        return 0;
+    }
+    if ((argc == 3 || argc == 4) && strcmp(argv[1], "start") == 0) {
+        if (cfg.running) {
+            puts("replay: already running");
+            return 1;
+        }
+        memset(&stats, 0, sizeof(stats));
+        cfg.rate = strtoul(argv[2], NULL, 10);
+        cfg.count = (argc == 4) ? strtoul(argv[3], NULL, 10) : 0;
+        if (cfg.rate == 0 || cfg.rate > RATE_MAX) {
+            printf("replay: rate must be 1 to %u frames/s\n",
+                   (unsigned)RATE_MAX);
+            return 1;
+        }
+        cfg.running = true;
+        thread_wakeup(replay_pid);
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "stop") == 0) {
+        cfg.running = false;
+        return 0;
+    }
+    if (argc == 2 && strcmp(argv[1], "stats") == 0) {
+        print_stats();
+        return 0;
+    }
+
+    printf("usage: %s file <pcap>|synth <len>\n", argv[0]);
+    printf("       %s start <frames/s> [count]|stop|stats\n", argv[0]);
+    return 1;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* SNIFFER_REPLAY */
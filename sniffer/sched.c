@@ -0,0 +1,269 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     app_sniffer
+ * @{
+ *
+ * @file
+ * @brief       Capture scheduler for the sniffer
+ *
+ * Either cycles a network interface across a list of channels, dwelling on each
+ * for a fixed time, or pins each of several interfaces to a channel. The
+ * scheduler knows the channel of each interface it manages, so a frame is
+ * tagged with its channel without asking the interface. A frame still queued
+ * when the channel changes may be tagged with the new channel.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "msg.h"
+#include "net/gnrc.h"
+#include "net/gnrc/netif.h"
+#include "thread.h"
+#include "xtimer.h"
+
+#include "sniffer.h"
+
+/**
+ * @brief   Max channels in a hopping list
+ */
+#ifndef SNIFFER_HOP_MAX
+#define SNIFFER_HOP_MAX         (16U)
+#endif
+
+/**
+ * @brief   Count of channels tracked; IEEE 802.15.4 pages 0 to 2 use 0 to 26
+ */
+#define CHAN_NUMOF              (27U)
+
+#define SCHED_PRIO              (THREAD_PRIORITY_MAIN - 3)
+#define SCHED_MSG_TYPE          (0x5302)
+
+/**
+ * @brief   Interfaces with a channel set by the scheduler
+ */
+static struct {
+    kernel_pid_t pid;
+    uint8_t chan;
+} netifs[GNRC_NETIF_NUMOF];
+
+/**
+ * @brief   Hopping configuration
+ */
+static struct {
+    kernel_pid_t pid;           /**< interface, or KERNEL_PID_UNDEF if off */
+    uint32_t dwell_us;
+    uint8_t chans[SNIFFER_HOP_MAX];
+    unsigned count;
+    unsigned next;
+} hop = { .pid = KERNEL_PID_UNDEF };
+
+static uint32_t chan_frames[CHAN_NUMOF];
+static uint64_t chan_listen_us[CHAN_NUMOF];
+
+static kernel_pid_t sched_pid = KERNEL_PID_UNDEF;
+static char sched_stack[THREAD_STACKSIZE_DEFAULT];
+
+/**
+ * @brief   Set the channel of an interface, and remember it
+ *
+ * @return  0 on success, -1 on failure
+ */
+static int set_chan(kernel_pid_t pid, uint8_t chan)
+{
+    uint16_t val = chan;
+
+    if (gnrc_netapi_set(pid, NETOPT_CHANNEL, 0, &val, sizeof(val)) < 0) {
+        return -1;
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+        if (netifs[i].pid == pid || netifs[i].pid == KERNEL_PID_UNDEF) {
+            netifs[i].pid = pid;
+            netifs[i].chan = chan;
+            return 0;
+        }
+    }
+    return 0;
+}
+
+static void *sched_thread(void *arg)
+{
+    msg_t msg_q[2];
+    uint32_t last = xtimer_now_usec();
+
+    (void)arg;
+    msg_init_queue(msg_q, 2);
+    while (1) {
+        msg_t msg;
+
+        if (hop.pid == KERNEL_PID_UNDEF) {
+            msg_receive(&msg);
+            last = xtimer_now_usec();
+            continue;
+        }
+        if (xtimer_msg_receive_timeout(&msg, hop.dwell_us) >= 0) {
+            /* reconfigured; start over */
+            last = xtimer_now_usec();
+            continue;
+        }
+        if (hop.pid == KERNEL_PID_UNDEF || hop.count == 0) {
+            continue;
+        }
+
+        uint32_t now = xtimer_now_usec();
+        int cur = sched_chan(hop.pid);
+        if (cur >= 0 && cur < (int)CHAN_NUMOF) {
+            chan_listen_us[cur] += now - last;
+        }
+        last = now;
+        set_chan(hop.pid, hop.chans[hop.next]);
+        hop.next = (hop.next + 1) % hop.count;
+    }
+
+    /* never reached */
+    return NULL;
+}
+
+void sched_init(void)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+        netifs[i].pid = KERNEL_PID_UNDEF;
+    }
+    sched_pid = thread_create(sched_stack, sizeof(sched_stack), SCHED_PRIO,
+                              THREAD_CREATE_STACKTEST, sched_thread, NULL,
+                              "sched");
+}
+
+int sched_chan(kernel_pid_t pid)
+{
+    for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+        if (netifs[i].pid == pid) {
+            return netifs[i].chan;
+        }
+    }
+    return -1;
+}
+
+void sched_count(uint8_t chan)
+{
+    if (chan < CHAN_NUMOF) {
+        chan_frames[chan]++;
+    }
+}
+
+/**
+ * @brief   Start hopping: <iface> <dwell ms> <chan> [chan ...]
+ */
+static int start_hop(int argc, char **argv)
+{
+    kernel_pid_t pid = atoi(argv[0]);
+    uint32_t dwell_ms = strtoul(argv[1], NULL, 10);
+    unsigned count = argc - 2;
+
+    if (gnrc_netif_get_by_pid(pid) == NULL || dwell_ms == 0
+            || count == 0 || count > SNIFFER_HOP_MAX) {
+        return -1;
+    }
+    for (unsigned i = 0; i < count; i++) {
+        unsigned chan = atoi(argv[2 + i]);
+        if (chan >= CHAN_NUMOF) {
+            return -1;
+        }
+        hop.chans[i] = chan;
+    }
+    hop.pid = KERNEL_PID_UNDEF;
+    hop.count = count;
+    hop.dwell_us = dwell_ms * US_PER_MS;
+    hop.next = (count > 1) ? 1 : 0;
+    if (set_chan(pid, hop.chans[0]) < 0) {
+        return -1;
+    }
+    hop.pid = pid;
+
+    msg_t msg = { .type = SCHED_MSG_TYPE };
+    msg_try_send(&msg, sched_pid);
+    return 0;
+}
+
+static void print_chans(void)
+{
+    if (hop.pid != KERNEL_PID_UNDEF) {
+        printf("hopping iface %d, %lu ms per channel\n", hop.pid,
+               (unsigned long)(hop.dwell_us / US_PER_MS));
+    }
+    for (unsigned i = 0; i < GNRC_NETIF_NUMOF; i++) {
+        if (netifs[i].pid != KERNEL_PID_UNDEF) {
+            printf("iface %d on channel %u\n", netifs[i].pid, netifs[i].chan);
+        }
+    }
+    puts("chan   frames  listen ms   frames/s");
+    for (unsigned chan = 0; chan < CHAN_NUMOF; chan++) {
+        if (chan_frames[chan] == 0 && chan_listen_us[chan] == 0) {
+            continue;
+        }
+        uint32_t listen_ms = chan_listen_us[chan] / US_PER_MS;
+        printf("%4u %8lu %10lu", chan, (unsigned long)chan_frames[chan],
+               (unsigned long)listen_ms);
+        if (listen_ms) {
+            printf(" %10lu\n",
+                   (unsigned long)((uint64_t)chan_frames[chan] * 1000 / listen_ms));
+        }
+        else {
+            puts("          -");
+        }
+    }
+}
+
+int sched_cmd(int argc, char **argv)
+{
+    if (argc == 2 && strcmp(argv[1], "chans") == 0) {
+        print_chans();
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "chans") == 0
+            && strcmp(argv[2], "reset") == 0) {
+        memset(chan_frames, 0, sizeof(chan_frames));
+        memset(chan_listen_us, 0, sizeof(chan_listen_us));
+        return 0;
+    }
+    if (argc == 3 && strcmp(argv[1], "hop") == 0
+            && strcmp(argv[2], "off") == 0) {
+        hop.pid = KERNEL_PID_UNDEF;
+        msg_t msg = { .type = SCHED_MSG_TYPE };
+        msg_try_send(&msg, sched_pid);
+        return 0;
+    }
+    if (argc >= 5 && strcmp(argv[1], "hop") == 0) {
+        if (start_hop(argc - 2, &argv[2]) == 0) {
+            return 0;
+        }
+    }
+    if (argc == 4 && strcmp(argv[1], "pin") == 0) {
+        kernel_pid_t pid = atoi(argv[2]);
+        unsigned chan = atoi(argv[3]);
+        if (pid == hop.pid) {
+            hop.pid = KERNEL_PID_UNDEF;
+        }
+        if (gnrc_netif_get_by_pid(pid) != NULL && chan < CHAN_NUMOF
+                && set_chan(pid, chan) == 0) {
+            return 0;
+        }
+    }
+
+    printf("usage: %s hop <iface> <dwell ms> <chan> [chan ...]|off\n", argv[0]);
+    printf("       %s pin <iface> <chan>\n", argv[0]);
+    printf("       %s chans [reset]\n", argv[0]);
+    return 1;
+}
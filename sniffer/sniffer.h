@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     app_sniffer
+ * @{
+ *
+ * @file
+ * @brief       Definitions shared by the modules of the sniffer application
+ *
+ * @author      agent <agent@local>
+ */
+
+#ifndef SNIFFER_H
+#define SNIFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "kernel_types.h"
+#include "tsrb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief   Radio metadata of a received frame; precedes the frame in the ring
+ */
+typedef struct {
+    uint64_t rx_time;           /**< time of reception, in usec */
+    uint16_t len;               /**< length of the frame as captured */
+    kernel_pid_t netif;         /**< interface that received the frame */
+    uint8_t lqi;                /**< link quality indicator */
+    int8_t rssi;                /**< received signal strength, in dBm */
+    uint8_t chan;               /**< channel */
+    uint8_t flags;              /**< BIN_FLAG_TRUNCATED if truncated */
+} rx_info_t;
+
+/**
+ * @brief   Check a frame against the capture filters
+ *
+ * A filter that needs the MAC header rejects a frame that is not a valid
+ * IEEE 802.15.4 frame.
+ *
+ * @param[in] mhr   start of the frame
+ * @param[in] size  bytes available at @p mhr
+ * @param[in] len   length of the whole frame
+ * @param[in] lqi   link quality of the frame
+ *
+ * @return  true if the frame passes all enabled filters
+ */
+bool filter_match(const uint8_t *mhr, size_t size, size_t len, uint8_t lqi);
+
+/**
+ * @brief   Get the snap length
+ *
+ * @return  max bytes of a frame to capture, or 0 for no limit
+ */
+size_t filter_snaplen(void);
+
+/**
+ * @brief   Handler for the 'sniffer filter' and 'sniffer snaplen' commands
+ */
+int filter_cmd(int argc, char **argv);
+
+/**
+ * @brief   Start the capture scheduler thread
+ */
+void sched_init(void);
+
+/**
+ * @brief   Get the channel of an interface, if set by the scheduler
+ *
+ * @return  channel, or -1 if not set by the scheduler
+ */
+int sched_chan(kernel_pid_t pid);
+
+/**
+ * @brief   Count a frame received on a channel
+ */
+void sched_count(uint8_t chan);
+
+/**
+ * @brief   Handler for the 'sniffer hop', 'pin' and 'chans' commands
+ */
+int sched_cmd(int argc, char **argv);
+
+/**
+ * @brief   Export a frame from the ring in a ZEP datagram
+ *
+ * Reads the frame from @p ring. The datagram is sent when the batch is
+ * complete.
+ *
+ * @param[in] info  metadata of the frame
+ * @param[in] ring  ring buffer at the start of the frame
+ */
+void zep_write(const rx_info_t *info, tsrb_t *ring);
+
+/**
+ * @brief   Send the datagram in progress, if any
+ */
+void zep_flush(void);
+
+/**
+ * @brief   Print ZEP export statistics
+ */
+void zep_stats(void);
+
+/**
+ * @brief   Configure ZEP export, from 'sniffer out zep ...'
+ *
+ * @return  0 on success, -1 on a bad argument
+ */
+int zep_config(int argc, char **argv);
+
+/**
+ * @brief   Create the replay network device and its thread
+ */
+void replay_init(void);
+
+/**
+ * @brief   Handler for the 'replay' shell command
+ */
+int replay_cmd(int argc, char **argv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SNIFFER_H */
+/** @} */
@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# Copyright (C) 2026 agent
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Benchmark for the host side parser in sniffer.py.
+
+Replays a recorded serial log of the sniffer application through the parser
+and the pcap(ng) writer, as fast as possible, and reports packets per second.
+Record a log from a board with, for example:
+
+    stty -F /dev/ttyUSB0 115200 raw && cat /dev/ttyUSB0 > sniffer.log
+
+Or generate a log of synthetic frames with -g.
+'''
+
+import argparse
+import io
+import os
+import sys
+from random import randint
+from struct import pack
+from time import time
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import sniffer  # noqa: E402
+
+
+class EndOfLog(Exception):
+    pass
+
+
+class LogPort(object):
+    '''Serial port replaying a log; raises EndOfLog when the log is consumed,
+    and returns at most chunk bytes at a time, like a serial port'''
+
+    def __init__(self, data, chunk=4096):
+        self.log = io.BytesIO(data)
+        self.size = len(data)
+        self.chunk = chunk
+
+    @property
+    def in_waiting(self):
+        return min(self.size - self.log.tell(), self.chunk)
+
+    def readline(self):
+        line = self.log.readline()
+        if not line:
+            raise EndOfLog()
+        return line
+
+    def read(self, size=1):
+        data = self.log.read(size)
+        if not data:
+            raise EndOfLog()
+        return data
+
+
+class NullFile(object):
+    def write(self, data):
+        pass
+
+    def flush(self):
+        pass
+
+
+def synth_frame(seq, length):
+    # data frame, PAN ID compression, short addresses
+    mhr = bytes(bytearray([0x41, 0x88, seq & 0xff, 0x23, 0x00, 0xff, 0xff,
+                           0x01, 0x00]))
+    return mhr + bytes(bytearray(randint(0, 255)
+                                 for _ in range(length - len(mhr))))
+
+
+def generate_log(fmt, count, length):
+    end = bytes(bytearray([sniffer.SLIP_END]))
+    esc = bytes(bytearray([sniffer.SLIP_ESC]))
+    parts = []
+    for seq in range(count):
+        frame = synth_frame(seq, length)
+        rx_time = seq * 1000
+        if fmt == 'text':
+            parts.append(('rftest-rx --- len %08x lqi %02x rx_time %016x '
+                          'chan %02x\n' % (length, 0xff, rx_time, 26))
+                         .encode())
+            parts.append(b''.join(b'%02x ' % b for b in bytearray(frame)) +
+                         b'\n\n')
+        else:
+            data = pack(sniffer.BIN_HEADER, sniffer.BIN_MAGIC,
+                        sniffer.BIN_VERSION, length, 0xff, -70, 26, 0,
+                        rx_time) + frame
+            data = data.replace(esc, esc + bytes(bytearray(
+                                [sniffer.SLIP_ESC_ESC]))) \
+                       .replace(end, esc + bytes(bytearray(
+                                [sniffer.SLIP_END_ESC])))
+            parts.append(end + data + end)
+    return b''.join(parts)
+
+
+def run(data, args):
+    out = sniffer.BufferedOutput(NullFile(), args.flush_interval / 1000.0,
+                                 progress=False)
+    if args.file_format == 'pcap':
+        writer = sniffer.PcapWriter(out)
+    else:
+        writer = sniffer.PcapngWriter(out)
+    port = LogPort(data)
+    start = time()
+    try:
+        if args.format == 'slip':
+            sniffer.generate_pcap_slip(port, writer)
+        else:
+            sniffer.generate_pcap(port, writer, 26)
+    except EndOfLog:
+        pass
+    out.flush()
+    return out.packets, time() - start
+
+
+def main():
+    p = argparse.ArgumentParser(description='sniffer.py parser benchmark')
+    p.add_argument('log', nargs='?', help='recorded serial log')
+    p.add_argument('-f', '--format', choices=['text', 'slip'],
+                   default='text', help='format of the log (default: text)')
+    p.add_argument('-F', '--file-format', choices=['pcapng', 'pcap'],
+                   default='pcapng', help='capture file format '
+                                          '(default: pcapng)')
+    p.add_argument('-t', '--flush-interval', type=int, default=0,
+                   help='flush interval in ms, as for sniffer.py '
+                        '(default: 0)')
+    p.add_argument('-g', '--generate', type=int, metavar='FRAMES',
+                   help='replay a log of synthetic frames, rather than a '
+                        'recorded one')
+    p.add_argument('-l', '--length', type=int, default=40,
+                   help='length of synthetic frames (default: 40)')
+    p.add_argument('-n', '--runs', type=int, default=3,
+                   help='count of runs; the best is reported (default: 3)')
+    args = p.parse_args()
+
+    if args.generate:
+        data = generate_log(args.format, args.generate, args.length)
+    elif args.log:
+        with open(args.log, 'rb') as log:
+            data = log.read()
+    else:
+        p.error('give a log file, or -g for synthetic frames')
+
+    best = None
+    for _ in range(args.runs):
+        packets, elapsed = run(data, args)
+        if best is None or elapsed < best:
+            best = elapsed
+    print('%d packets, %d KiB of %s log' % (packets, len(data) // 1024,
+                                            args.format))
+    print('%.0f packets/s, %.1f MiB/s' % (packets / best,
+                                          len(data) / best / 1048576))
+
+
+if __name__ == '__main__':
+    main()
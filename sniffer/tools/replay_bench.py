@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+# Copyright (C) 2026 agent
+#
+# This file is subject to the terms and conditions of the GNU Lesser
+# General Public License v2.1. See the file LICENSE in the top level
+# directory for more details.
+
+'''
+Capture throughput benchmark for the sniffer application on native.
+
+Runs the application built with the replay device, and replays frames at each
+requested rate, once for each output format. Reports the sustained rate of
+frames captured, the frames dropped by the replay queue, by the stack and by
+the sniffer's ring, and the CPU time of the process per frame captured.
+
+Build and run with:
+
+    BOARD=native SNIFFER_REPLAY=1 make bench
+    BOARD=native SNIFFER_REPLAY=1 make bench BENCH_ARGS="-r 20000 -p foo.pcap"
+'''
+
+import argparse
+import csv
+import os
+import re
+import subprocess
+import sys
+import threading
+import time
+
+CLK_TCK = os.sysconf('SC_CLK_TCK')
+# highest rate of the replay device: 64 frames per 1 ms tick
+RATE_MAX = 64000
+
+FIELDS = ['format', 'rate', 'frames', 'captured', 'fps', 'overruns',
+          'stack_drops', 'ring_drops', 'cpu_us_per_frame', 'out_kbytes']
+
+
+class Sniffer(object):
+    '''A native sniffer process; reads its output as fast as it arrives'''
+
+    def __init__(self, elf):
+        self.proc = subprocess.Popen([elf], stdin=subprocess.PIPE,
+                                     stdout=subprocess.PIPE,
+                                     stderr=subprocess.STDOUT)
+        self.lock = threading.Lock()
+        self.out_bytes = 0
+        # text output, for replies to commands; frames are discarded
+        self.text = b''
+        self.reader = threading.Thread(target=self._read, daemon=True)
+        self.reader.start()
+
+    def _read(self):
+        fd = self.proc.stdout.fileno()
+        while True:
+            data = os.read(fd, 65536)
+            if not data:
+                break
+            with self.lock:
+                self.out_bytes += len(data)
+                self.text = (self.text + data)[-8192:]
+
+    def cmd(self, line):
+        self.proc.stdin.write(line.encode() + b'\n')
+        self.proc.stdin.flush()
+
+    def query(self, line, regex, timeout=5):
+        '''Sends a command, and returns the first match of regex in the output
+        that follows'''
+        with self.lock:
+            self.text = b''
+        self.cmd(line)
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            with self.lock:
+                match = re.search(regex, self.text.decode(errors='ignore'))
+            if match:
+                return match
+            time.sleep(0.05)
+        sys.exit('error: no reply to "{}"'.format(line))
+
+    def cpu_seconds(self):
+        with open('/proc/{}/stat'.format(self.proc.pid)) as stat:
+            fields = stat.read().rsplit(')', 1)[1].split()
+        return (int(fields[11]) + int(fields[12])) / CLK_TCK
+
+    def stop(self):
+        self.proc.terminate()
+        try:
+            self.proc.wait(timeout=2)
+        except subprocess.TimeoutExpired:
+            self.proc.kill()
+
+
+def run(args, fmt, rate):
+    sniffer = Sniffer(args.elf)
+    try:
+        sniffer.query('help', r'sniffer')
+        if args.pcap:
+            sniffer.query('replay file {}'.format(os.path.abspath(args.pcap)),
+                          r'replay: (\d+) frames')
+        else:
+            sniffer.cmd('replay synth {}'.format(args.length))
+        sniffer.cmd('sniffer out {}'.format(fmt))
+
+        cpu_start = sniffer.cpu_seconds()
+        bytes_start = sniffer.out_bytes
+        sniffer.cmd('replay start {} {}'.format(rate, args.count))
+        # wait for the replay to complete, then for the output to drain
+        deadline = time.monotonic() + 2 * args.count / rate + 10
+        while time.monotonic() < deadline:
+            time.sleep(0.5)
+            if sniffer.query('replay stats', r'replay: (running|idle)') \
+                    .group(1) == 'idle':
+                break
+        time.sleep(1)
+        cpu = sniffer.cpu_seconds() - cpu_start
+        out_bytes = sniffer.out_bytes - bytes_start
+
+        replay = sniffer.query('replay stats',
+                               r'replay: (\d+) sent, (\d+) overruns, (\d+) '
+                               r'received, (\d+) dropped by stack\s+'
+                               r'replay: (\d+) ms')
+        ring = sniffer.query('sniffer stats', r'frames: (\d+), dropped: (\d+)')
+    finally:
+        sniffer.stop()
+
+    sent, overruns, received, stack_drops, elapsed_ms = \
+        [int(v) for v in replay.groups()]
+    frames, ring_drops = [int(v) for v in ring.groups()]
+    captured = frames - ring_drops
+    return {
+        'format': fmt,
+        'rate': rate,
+        'frames': sent + overruns,
+        'captured': captured,
+        'fps': int(captured * 1000 / elapsed_ms) if elapsed_ms else 0,
+        'overruns': overruns,
+        'stack_drops': stack_drops,
+        'ring_drops': ring_drops,
+        'cpu_us_per_frame': '{:.1f}'.format(cpu * 1e6 / captured)
+                            if captured else '',
+        'out_kbytes': out_bytes // 1024,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description='sniffer capture benchmark')
+    parser.add_argument('elf', help='native sniffer binary, with replay')
+    parser.add_argument('-f', '--formats', default='text,slip',
+                        help='comma separated output formats; default '
+                             'text,slip')
+    parser.add_argument('-r', '--rate', default='1000,5000,20000',
+                        help='comma separated frames per second; default '
+                             '1000,5000,20000')
+    parser.add_argument('-n', '--count', type=int, default=10000,
+                        help='frames per run; default 10000')
+    parser.add_argument('-l', '--length', type=int, default=40,
+                        help='length of synthetic frames; default 40')
+    parser.add_argument('-p', '--pcap', help='802.15.4 pcap file to replay, '
+                                             'rather than synthetic frames')
+    parser.add_argument('-o', '--output', help='CSV file for results')
+    args = parser.parse_args()
+    rates = [int(r) for r in args.rate.split(',')]
+    if not all(0 < r <= RATE_MAX for r in rates):
+        parser.error('rates must be 1 to {}'.format(RATE_MAX))
+
+    results = []
+    print('{:>6} {:>7} {:>7} {:>8} {:>7} {:>6} {:>6} {:>6} {:>9}'.format(
+          'format', 'rate', 'frames', 'captured', 'fps', 'overrun', 'stack',
+          'ring', 'cpu us/f'))
+    for fmt in args.formats.split(','):
+        for rate in rates:
+            res = run(args, fmt, rate)
+            results.append(res)
+            print('{format:>6} {rate:>7} {frames:>7} {captured:>8} {fps:>7} '
+                  '{overruns:>7} {stack_drops:>6} {ring_drops:>6} '
+                  '{cpu_us_per_frame:>9}'.format(**res))
+
+    if args.output:
+        with open(args.output, 'w', newline='') as out:
+            writer = csv.DictWriter(out, fieldnames=FIELDS)
+            writer.writeheader()
+            writer.writerows(results)
+
+
+if __name__ == '__main__':
+    main()
@@ -34,14 +34,17 @@ SUCH DAMAGE.
 
 from __future__ import print_function
 import argparse
+import errno
+import os
 import sys
 import re
 import socket
+from binascii import unhexlify
 from time import sleep, time
-from struct import pack
+from struct import pack, unpack
 from serial import Serial
 
-# PCAP setup
+# PCAP setup, for the classic format
 MAGIC = 0xa1b2c3d4
 MAJOR = 2
 MINOR = 4
@@ -50,10 +53,42 @@ SIG = 0
 SNAPLEN = 0xffff
 NETWORK = 230       # 802.15.4 no FCS
 
+# PCAPNG setup
+PCAPNG_SHB = 0x0a0d0d0a
+PCAPNG_IDB = 0x00000001
+PCAPNG_EPB = 0x00000006
+PCAPNG_BYTE_ORDER = 0x1a2b3c4d
+PCAPNG_OPT_IF_TSRESOL = 9
+NETWORK_TAP = 283   # 802.15.4 with TAP header for radio metadata
+
+# 802.15.4 TAP TLV types
+TAP_FCS_TYPE = 0
+TAP_RSS = 1
+TAP_CHANNEL = 3
+TAP_LQI = 10
+TAP_FCS_NONE = 0
+
 DEFAULT_BAUDRATE = 115200
 
+# SLIP framing, RFC 1055
+SLIP_END = 0xc0
+SLIP_ESC = 0xdb
+SLIP_END_ESC = 0xdc
+SLIP_ESC_ESC = 0xdd
+
+# binary frame header: magic, version, len, lqi, rssi, chan, flags, rx_time
+BIN_HEADER = '<BBHBbBBQ'
+BIN_HEADER_LEN = 16
+BIN_MAGIC = 0x52
+BIN_VERSION = 1
 
-def configure_interface(port, channel):
+# header line of a frame in text format; the data line follows
+PKT_HEADER = re.compile(br">? *rftest-rx --- len (\w+)"
+                        br"(?: lqi (\w+) rx_time (\w+))?"
+                        br"(?: chan (\w+))?")
+
+
+def configure_interface(port, channel, fmt, hop=None, dwell=None):
     line = ""
     iface = 0
     port.write(b'ifconfig\n')
@@ -75,38 +110,202 @@ def configure_interface(port, channel):
     port.write(('ifconfig %d set chan %d\n' % (iface, channel)).encode())
     port.write(('ifconfig %d raw\n' % iface).encode())
     port.write(('ifconfig %d promisc\n' % iface).encode())
+    if hop:
+        cmd = 'sniffer hop %d %d %s' % (iface, dwell, ' '.join(map(str, hop)))
+        print(cmd, file=sys.stderr)
+        port.write((cmd + '\n').encode())
+    if fmt != 'text':
+        print('sniffer out %s' % fmt, file=sys.stderr)
+        port.write(('sniffer out %s\n' % fmt).encode())
+
+
+class DeviceClock(object):
+    """Converts device timestamps in usec to host time in usec. The device time
+    is anchored to the host time when the first frame arrives, so delay in the
+    serial link does not skew the interval between frames. Re-anchors if the
+    device time goes backwards, for a device reset."""
+
+    def __init__(self):
+        self.offset = None
+        self.last = 0
+
+    def host_usec(self, device_usec):
+        if device_usec is None:
+            return int(time() * 1000000)
+        if self.offset is None or device_usec < self.last:
+            self.offset = int(time() * 1000000) - device_usec
+        self.last = device_usec
+        return self.offset + device_usec
+
+
+class BufferedOutput(object):
+    """Collects the output for packets, and writes it when a packet ends, or
+    with an interval, at most once per interval. Buffering a burst of packets
+    saves a write and flush for each one. Call poll() when no data arrives, so
+    the last packets are written once the interval expires."""
+
+    def __init__(self, out, interval=0, progress=True):
+        self.out = out
+        self.interval = interval
+        self.progress = progress
+        self.chunks = []
+        self.last = time()
+        self.packets = 0
+
+    def write(self, data):
+        self.chunks.append(data)
+
+    def end_packet(self):
+        self.packets += 1
+        self.poll()
+
+    def poll(self):
+        if self.chunks and time() - self.last >= self.interval:
+            self.flush()
+
+    def flush(self):
+        self.out.write(b''.join(self.chunks))
+        self.out.flush()
+        self.chunks = []
+        self.last = time()
+        if self.progress:
+            sys.stderr.write("RX: %i\r" % self.packets)
+
+
+class PcapWriter(object):
+    """Classic pcap output; without radio metadata"""
+
+    def __init__(self, out):
+        self.out = out
+        self.clock = DeviceClock()
+        out.write(pack('<LHHLLLL', MAGIC, MAJOR, MINOR, ZONE, SIG, SNAPLEN,
+                       NETWORK))
+
+    def write(self, frame, rx_time=None, lqi=None, rssi=None, chan=None):
+        sec, usec = divmod(self.clock.host_usec(rx_time), 1000000)
+        self.out.write(pack('<LLLL', sec, usec, len(frame), len(frame)))
+        self.out.write(frame)
+        self.out.end_packet()
+
+
+def pad4(data):
+    return data + b'\0' * (-len(data) % 4)
+
+
+class PcapngWriter(object):
+    """pcapng output, with the 802.15.4 TAP link type for LQI, RSSI and
+    channel, and usec timestamps"""
 
+    def __init__(self, out):
+        self.out = out
+        self.clock = DeviceClock()
+        self._block(PCAPNG_SHB, pack('<LHHq', PCAPNG_BYTE_ORDER, 1, 0, -1))
+        options = pack('<HH', PCAPNG_OPT_IF_TSRESOL, 1) + pad4(b'\x06') + \
+            pack('<HH', 0, 0)
+        self._block(PCAPNG_IDB, pack('<HHL', NETWORK_TAP, 0, 0) + options)
 
-def generate_pcap(port, out):
-    # count incoming packets
-    count = 0
-    # output overall PCAP header
-    out.write(pack('<LHHLLLL', MAGIC, MAJOR, MINOR, ZONE, SIG, SNAPLEN,
-                   NETWORK))
-    sys.stderr.write("RX: %i\r" % count)
+    def _block(self, block_type, body):
+        body = pad4(body)
+        length = len(body) + 12
+        self.out.write(pack('<LL', block_type, length) + body +
+                       pack('<L', length))
+
+    @staticmethod
+    def _tap_header(lqi, rssi, chan):
+        tlvs = pack('<HHB3x', TAP_FCS_TYPE, 1, TAP_FCS_NONE)
+        if rssi is not None:
+            tlvs += pack('<HHf', TAP_RSS, 4, rssi)
+        if chan is not None:
+            tlvs += pack('<HHHBx', TAP_CHANNEL, 3, chan, 0)
+        if lqi is not None:
+            tlvs += pack('<HHB3x', TAP_LQI, 1, lqi)
+        return pack('<BBH', 0, 0, 4 + len(tlvs)) + tlvs
+
+    def write(self, frame, rx_time=None, lqi=None, rssi=None, chan=None):
+        usec = self.clock.host_usec(rx_time)
+        data = self._tap_header(lqi, rssi, chan) + frame
+        self._block(PCAPNG_EPB, pack('<LLLLL', 0, usec >> 32,
+                                     usec & 0xffffffff, len(data), len(data)) +
+                    data)
+        self.out.end_packet()
+
+
+def slip_decode(data):
+    # the order matters, so an escaped ESC is not decoded twice
+    return data.replace(bytes(bytearray([SLIP_ESC, SLIP_END_ESC])),
+                        bytes(bytearray([SLIP_END]))) \
+               .replace(bytes(bytearray([SLIP_ESC, SLIP_ESC_ESC])),
+                        bytes(bytearray([SLIP_ESC])))
+
+
+def read_available(port):
+    """Reads at least one byte, and any more already received"""
+    data = port.read(1)
+    waiting = getattr(port, 'in_waiting', 0)
+    if data and waiting:
+        data += port.read(waiting)
+    return data
+
+
+def parse_frame(data):
+    """Returns (header fields, frame) for a binary frame, or None for other
+    data, like shell output"""
+    if len(data) < BIN_HEADER_LEN:
+        return None
+    hdr = unpack(BIN_HEADER, data[:BIN_HEADER_LEN])
+    magic, version, length = hdr[:3]
+    if magic != BIN_MAGIC or version != BIN_VERSION or \
+            length != len(data) - BIN_HEADER_LEN:
+        return None
+    return hdr, data[BIN_HEADER_LEN:]
+
+
+def generate_pcap_slip(port, writer):
+    pending = b''
     while True:
-        line = port.readline().rstrip()
+        data = read_available(port)
+        if not data:
+            writer.out.poll()
+            continue
+        chunks = (pending + data).split(bytes(bytearray([SLIP_END])))
+        pending = chunks.pop()
+        for chunk in chunks:
+            frame = parse_frame(slip_decode(chunk))
+            if frame is None:
+                continue
+            hdr, data = frame
+            lqi, rssi, chan, rx_time = hdr[3], hdr[4], hdr[5], hdr[7]
+            writer.write(data, rx_time, lqi, rssi, chan)
 
-        pkt_header = re.match(r">? *rftest-rx --- len (\w+).*",
-                              line.decode(errors="ignore"))
-        if pkt_header:
-            now = time()
-            sec = int(now)
-            usec = int((now - sec) * 1000000)
-            length = int(pkt_header.group(1), 16)
-            out.write(pack('<LLLL', sec, usec, length, length))
-            out.flush()
-            count += 1
-            sys.stderr.write("RX: %i\r" % count)
+
+def generate_pcap(port, writer, channel):
+    # metadata from the last header line, for the data line that follows
+    meta = None
+    while True:
+        line = port.readline()
+        if not line:
+            writer.out.poll()
             continue
 
-        pkt_data = re.match(r"(\w\w )+", line.decode(errors="ignore"))
-        if pkt_data:
-            for part in line.decode(errors="ignore").split(' '):
-                byte = re.match(r"(\w\w)", part)
-                if byte:
-                    out.write(pack('<B', int(byte.group(1), 16)))
-            out.flush()
+        if meta:
+            # decode the whole data line at once, like "41 88 2a ... "
+            try:
+                frame = unhexlify(line.rstrip().replace(b' ', b''))
+            except (TypeError, ValueError):
+                frame = None
+            if frame:
+                # text output has no RSSI
+                writer.write(frame, meta[0], meta[1], None, meta[2])
+                meta = None
+                continue
+            meta = None
+
+        pkt_header = PKT_HEADER.match(line)
+        if pkt_header:
+            lqi, rx_time, chan = pkt_header.group(2, 3, 4)
+            meta = (int(rx_time, 16) if rx_time else None,
+                    int(lqi, 16) if lqi else None,
+                    int(chan, 16) if chan else channel)
 
 
 def connect(args):
@@ -137,6 +336,18 @@ def connect(args):
     return conn
 
 
+def open_pipe(path):
+    """Opens a named pipe for writing, and creates it if it does not exist.
+    Blocks until a reader, like Wireshark, opens the pipe."""
+    created = False
+    if not os.path.exists(path):
+        os.mkfifo(path)
+        created = True
+    print("waiting for a reader on %s, like: wireshark -k -i %s" %
+          (path, path), file=sys.stderr)
+    return open(path, "wb"), created
+
+
 def main():
     if sys.version_info > (3,):
         default_outfile = sys.stdout.buffer
@@ -147,27 +358,75 @@ def main():
                    help="Baudrate of the serial port (only evaluated "
                         "for non TCP-terminal, default: %d)" %
                         DEFAULT_BAUDRATE)
+    p.add_argument("-f", "--format", choices=["text", "slip"], default="text",
+                   help="Output format of the sniffer application; slip "
+                        "is binary, and needs about a third of the bandwidth "
+                        "(default: text)")
+    p.add_argument("-F", "--file-format", choices=["pcapng", "pcap"],
+                   default="pcapng",
+                   help="Capture file format; pcap has no LQI, RSSI or "
+                        "channel (default: pcapng)")
     p.add_argument("conn", metavar="tty/host:port", type=str,
                    help="Serial port or TCP (host, port) tuple to "
                         "terminal with sniffer application")
+    p.add_argument("-H", "--hop", type=lambda s: [int(c) for c in s.split(",")],
+                   help="Comma separated list of channels to cycle through, "
+                        "after the initial channel")
+    p.add_argument("-d", "--dwell", type=int, default=100,
+                   help="Time on each channel when hopping, in ms "
+                        "(default: 100)")
     p.add_argument("channel", type=int, help="Channel to sniff on")
+    p.add_argument("-t", "--flush-interval", type=int, default=0,
+                   help="Write the output at most once per interval, in ms, "
+                        "rather than for each packet (default: 0)")
+    p.add_argument("-p", "--pipe", metavar="PATH",
+                   help="Write to a named pipe, for live capture in "
+                        "Wireshark; created if it does not exist")
     p.add_argument("outfile", type=argparse.FileType("w+b"),
                    default=default_outfile, nargs="?",
-                   help="PCAP file to output to (default: stdout)")
+                   help="PCAP(NG) file to output to (default: stdout)")
     args = p.parse_args()
+    if args.pipe and args.outfile is not default_outfile:
+        p.error("outfile and --pipe are exclusive")
 
     conn = connect(args)
 
     sleep(1)
-    configure_interface(conn, args.channel)
+    hop = [args.channel] + args.hop if args.hop else None
+    configure_interface(conn, args.channel, args.format, hop, args.dwell)
     sleep(1)
 
+    created = False
+    if args.pipe:
+        outfile, created = open_pipe(args.pipe)
+    else:
+        outfile = args.outfile
+    out = BufferedOutput(outfile, args.flush_interval / 1000.0)
+    if args.file_format == "pcap":
+        writer = PcapWriter(out)
+    else:
+        writer = PcapngWriter(out)
+    # write the file header now, so a reader sees the link type at once
+    out.flush()
+
     try:
-        generate_pcap(conn, args.outfile)
+        if args.format == "slip":
+            generate_pcap_slip(conn, writer)
+        else:
+            generate_pcap(conn, writer, args.channel)
     except KeyboardInterrupt:
+        out.flush()
         conn.close()
         print()
         sys.exit(2)
+    except (IOError, OSError) as e:
+        if e.errno != errno.EPIPE:
+            raise
+        print("reader closed the pipe", file=sys.stderr)
+        conn.close()
+    finally:
+        if created:
+            os.remove(args.pipe)
 
 
 if __name__ == "__main__":
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2026 agent
+ *
+ * This file is subject to the terms and conditions of the GNU Lesser
+ * General Public License v2.1. See the file LICENSE in the top level
+ * directory for more details.
+ */
+
+/**
+ * @ingroup     app_sniffer
+ * @{
+ *
+ * @file
+ * @brief       ZEP export for the sniffer
+ *
+ * Wraps each captured frame in a ZigBee Encapsulation Protocol (ZEP) v2 data
+ * message, with an FCS appended, and sends it over UDP. Wireshark decodes ZEP on
+ * UDP port 17754. The device has no wall clock, so the ZEP timestamp is the
+ * receive time since boot.
+ *
+ * Optionally batches several ZEP messages in one datagram. Each message has its
+ * own header and length, but Wireshark decodes only the first message of a
+ * datagram, so batching is for a receiver which splits datagrams.
+ *
+ * @author      agent <agent@local>
+ *
+ * @}
+ */
+
+#ifdef SNIFFER_ZEP
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "checksum/ucrc16.h"
+#include "mutex.h"
+#include "net/gnrc/netif.h"
+#include "net/ipv6/addr.h"
+#include "net/sock/udp.h"
+
+#include "sniffer.h"
+
+/**
+ * @brief   Default UDP port for ZEP
+ */
+#define ZEP_PORT_DEFAULT        (17754U)
+
+/**
+ * @brief   Size of the datagram buffer; limits the batch size
+ */
+#ifndef SNIFFER_ZEP_BUF_SIZE
+#define SNIFFER_ZEP_BUF_SIZE    (512U)
+#endif
+
+#define ZEP_HDR_LEN             (32U)
+#define ZEP_VERSION             (2U)
+#define ZEP_TYPE_DATA           (1U)
+/* CRC mode: the frame ends in its FCS, not in CC24xx RSSI and LQI bytes */
+#define ZEP_CRC_MODE            (1U)
+#define ZEP_FCS_LEN             (2U)
+/* an 802.15.4 frame, including FCS */
+#define ZEP_FRAME_MAX           (127U)
+/* seconds from the NTP epoch, 1900, to the Unix epoch */
+#define NTP_UNIX_OFFSET         (2208988800UL)
+
+/*
+ * Guards cfg and the datagram buffer; the writer thread sends on the socket
+ * which the shell replaces in zep_config()
+ */
+static mutex_t lock = MUTEX_INIT;
+
+static struct {
+    bool ready;
+    sock_udp_t sock;
+    sock_udp_ep_t remote;
+    unsigned batch;             /* max messages per datagram */
+} cfg;
+
+static struct {
+    uint32_t frames;
+    uint32_t datagrams;
+    uint32_t errors;            /* send failures */
+    uint32_t too_long;          /* frames not 802.15.4, so not sent */
+} stats;
+
+static uint8_t buf[SNIFFER_ZEP_BUF_SIZE];
+static size_t buf_len;
+static unsigned buf_count;
+/* used only by the writer thread */
+static uint32_t seq;
+
+static void put_u32(uint8_t *pos, uint32_t val)
+{
+    pos[0] = val >> 24;
+    pos[1] = val >> 16;
+    pos[2] = val >> 8;
+    pos[3] = val;
+}
+
+/* Sends the buffered messages; call with lock held */
+static void _flush(void)
+{
+    if (!buf_count) {
+        return;
+    }
+    if (sock_udp_send(&cfg.sock, buf, buf_len, &cfg.remote) < 0) {
+        stats.errors++;
+    }
+    else {
+        stats.datagrams++;
+    }
+    buf_len = 0;
+    buf_count = 0;
+}
+
+void zep_flush(void)
+{
+    mutex_lock(&lock);
+    _flush();
+    mutex_unlock(&lock);
+}
+
+void zep_write(const rx_info_t *info, tsrb_t *ring)
+{
+    mutex_lock(&lock);
+    if (!cfg.ready || info->len + ZEP_FCS_LEN > ZEP_FRAME_MAX) {
+        /* skip the frame */
+        for (unsigned i = 0; i < info->len; i++) {
+            tsrb_get_one(ring);
+        }
+        if (cfg.ready) {
+            stats.too_long++;
+        }
+        mutex_unlock(&lock);
+        return;
+    }
+    if (buf_len + ZEP_HDR_LEN + info->len + ZEP_FCS_LEN > sizeof(buf)) {
+        _flush();
+    }
+
+    uint8_t *hdr = &buf[buf_len];
+    uint8_t *frame = hdr + ZEP_HDR_LEN;
+    uint64_t usec = info->rx_time;
+    uint32_t sec = usec / US_PER_SEC;
+
+    memset(hdr, 0, ZEP_HDR_LEN);
+    hdr[0] = 'E';
+    hdr[1] = 'X';
+    hdr[2] = ZEP_VERSION;
+    hdr[3] = ZEP_TYPE_DATA;
+    hdr[4] = info->chan;
+    hdr[5] = 0;
+    hdr[6] = info->netif;
+    hdr[7] = ZEP_CRC_MODE;
+    hdr[8] = info->lqi;
+    put_u32(&hdr[9], sec + NTP_UNIX_OFFSET);
+    /* fraction of a second, in 1/2^32 s */
+    put_u32(&hdr[13], ((usec % US_PER_SEC) << 32) / US_PER_SEC);
+    put_u32(&hdr[17], ++seq);
+    /* hdr[21..30] reserved */
+    hdr[31] = info->len + ZEP_FCS_LEN;
+
+    tsrb_get(ring, (char *)frame, info->len);
+    /* FCS, CRC-16 ITU-T as sent on the air, least significant byte first */
+    uint16_t fcs = ucrc16_calc_le(frame, info->len, UCRC16_CCITT_POLY_LE, 0);
+    frame[info->len] = fcs & 0xff;
+    frame[info->len + 1] = fcs >> 8;
+
+    buf_len += ZEP_HDR_LEN + info->len + ZEP_FCS_LEN;
+    stats.frames++;
+    if (++buf_count >= cfg.batch) {
+        _flush();
+    }
+    mutex_unlock(&lock);
+}
+
+void zep_stats(void)
+{
+    printf("zep: %lu frames in %lu datagrams, %lu errors, %lu too long\n",
+           (unsigned long)stats.frames, (unsigned long)stats.datagrams,
+           (unsigned long)stats.errors, (unsigned long)stats.too_long);
+}
+
+int zep_config(int argc, char **argv)
+{
+    sock_udp_ep_t local = SOCK_IPV6_EP_ANY;
+    sock_udp_ep_t remote = { .family = AF_INET6 };
+    ipv6_addr_t addr;
+    int res = 0;
+
+    if (argc < 1 || argc > 3) {
+        return -1;
+    }
+
+    remote.netif = SOCK_ADDR_ANY_NETIF;
+    int iface = ipv6_addr_split_iface(argv[0]);
+    if (iface >= 0) {
+        if (gnrc_netif_get_by_pid(iface) == NULL) {
+            puts("zep: interface not valid");
+            return -1;
+        }
+        remote.netif = iface;
+    }
+    if (ipv6_addr_from_str(&addr, argv[0]) == NULL) {
+        puts("zep: unable to parse address");
+        return -1;
+    }
+    memcpy(remote.addr.ipv6, &addr, sizeof(addr));
+    remote.port = (argc > 1) ? atoi(argv[1]) : ZEP_PORT_DEFAULT;
+    unsigned batch = (argc > 2) ? atoi(argv[2]) : 1;
+    if (batch == 0) {
+        batch = 1;
+    }
+
+    /* replace the socket while the writer thread is not sending on it */
+    mutex_lock(&lock);
+    if (cfg.ready) {
+        cfg.ready = false;
+        sock_udp_close(&cfg.sock);
+    }
+    buf_len = 0;
+    buf_count = 0;
+    local.netif = remote.netif;
+    if (sock_udp_create(&cfg.sock, &local, NULL, 0) < 0) {
+        puts("zep: unable to create socket");
+        res = -1;
+    }
+    else {
+        cfg.remote = remote;
+        cfg.batch = batch;
+        cfg.ready = true;
+    }
+    mutex_unlock(&lock);
+    return res;
+}
+
+#else
+typedef int dont_be_pedantic;
+#endif /* SNIFFER_ZEP */